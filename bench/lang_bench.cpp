@@ -0,0 +1,308 @@
+// Benchmarks de ponta a ponta: executa cada programa de bench/programs com o
+// binário lang, N vezes, e mede o tempo de parede (mediana, mínimo e máximo),
+// o pico de memória residente e as alocações do heap (via --gc-stats).
+//
+// O resultado sai em JSON, uma linha por programa, para comparar commits
+// com diff. O resumo legível vai para stderr.
+//
+// Uso: lang_bench [--lang=BIN] [--dir=DIR] [--runs=N] [--directive=-i|-vm]
+//                 [--out=ARQ] [filtro] [-- opções extras do lang]
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Benchmark
+    {
+        const char *name;       // bench/programs/<name>.lang
+        std::string (*input)(); // entrada padrão do programa, ou nullptr
+    };
+
+    // Entrada de read.lang: a quantidade n, n inteiros e n/2 floats.
+    std::string read_input()
+    {
+        const unsigned n = 500000;
+        std::string text = std::to_string(n) + '\n';
+        unsigned x = 12345;
+        for (unsigned i = 0; i < n; ++i)
+        {
+            x = x * 1103515245u + 12345u;
+            text += std::to_string((x >> 16) % 1000) + '\n';
+        }
+        for (unsigned i = 0; i < n / 2; ++i)
+            text += std::to_string(i % 1000) + ".25\n";
+        return text;
+    }
+
+    const Benchmark BENCHMARKS[] = {
+        {"arith", nullptr},
+        {"recursion", nullptr},
+        {"list", nullptr},
+        {"matmul", nullptr},
+        {"print", nullptr},
+        {"read", read_input},
+    };
+
+    struct Options
+    {
+        std::string lang = "./lang";
+        std::string dir = "bench/programs";
+        std::string directive = "-i";
+        std::string out; // vazio: stdout
+        std::string filter;
+        int runs = 5;
+        std::vector<std::string> extra;
+    };
+
+    struct Run
+    {
+        int status = 0; // código de saída (128 + sinal se terminou por sinal)
+        double ms = 0;
+        long peak_rss_kb = 0;
+        std::string errors; // stderr do lang
+    };
+
+    struct Result
+    {
+        std::string name;
+        int status = 0;
+        double median_ms = 0, min_ms = 0, max_ms = 0;
+        long peak_rss_kb = 0;
+        long long objects_allocated = -1; // -1: o lang não informou
+        long long bytes_allocated = -1;
+    };
+
+    // Arquivo temporário já removido do diretório; só o descritor fica.
+    int temp_fd()
+    {
+        char path[] = "/tmp/lang_bench.XXXXXX";
+        int fd = mkstemp(path);
+        if (fd >= 0)
+            unlink(path);
+        return fd;
+    }
+
+    std::string read_all(int fd)
+    {
+        std::string text;
+        char buffer[4096];
+        lseek(fd, 0, SEEK_SET);
+        for (ssize_t n; (n = read(fd, buffer, sizeof buffer)) > 0;)
+            text.append(buffer, static_cast<std::size_t>(n));
+        return text;
+    }
+
+    // Executa o lang uma vez; a saída padrão é descartada.
+    Run run_once(const Options &opt, const std::string &program, int input_fd)
+    {
+        std::vector<std::string> args{opt.lang, "--gc-stats"};
+        args.insert(args.end(), opt.extra.begin(), opt.extra.end());
+        args.push_back(opt.directive);
+        args.push_back(program);
+        std::vector<char *> argv;
+        for (std::string &arg : args)
+            argv.push_back(&arg[0]);
+        argv.push_back(nullptr);
+
+        Run run;
+        int err_fd = temp_fd();
+        if (err_fd < 0)
+        {
+            run.status = -1;
+            run.errors = std::strerror(errno);
+            return run;
+        }
+        if (input_fd >= 0)
+            lseek(input_fd, 0, SEEK_SET);
+
+        auto start = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            int null_fd = open("/dev/null", O_RDWR);
+            dup2(input_fd >= 0 ? input_fd : null_fd, STDIN_FILENO);
+            dup2(null_fd, STDOUT_FILENO);
+            dup2(err_fd, STDERR_FILENO);
+            execv(argv[0], argv.data());
+            std::fprintf(stderr, "execv %s: %s\n", argv[0], std::strerror(errno));
+            _exit(127);
+        }
+
+        int wstatus = 0;
+        struct rusage usage{};
+        if (pid < 0 || wait4(pid, &wstatus, 0, &usage) < 0)
+        {
+            run.status = -1;
+            run.errors = std::strerror(errno);
+            close(err_fd);
+            return run;
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        run.ms = elapsed.count();
+        run.peak_rss_kb = usage.ru_maxrss; // KiB no Linux
+        run.status = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128 + WTERMSIG(wstatus);
+        run.errors = read_all(err_fd);
+        close(err_fd);
+        return run;
+    }
+
+    // "[gc] alocados: X objetos / Y bytes", impresso por Heap::print_stats.
+    void parse_allocations(const std::string &errors, Result &result)
+    {
+        const char *line = std::strstr(errors.c_str(), "[gc] alocados:");
+        if (line)
+            std::sscanf(line, "[gc] alocados: %lld objetos / %lld bytes",
+                        &result.objects_allocated, &result.bytes_allocated);
+    }
+
+    Result measure(const Options &opt, const Benchmark &bench)
+    {
+        Result result;
+        result.name = bench.name;
+        std::string program = opt.dir + '/' + bench.name + ".lang";
+
+        int input_fd = -1;
+        if (bench.input)
+        {
+            input_fd = temp_fd();
+            std::string text = bench.input();
+            if (input_fd < 0 || write(input_fd, text.data(), text.size()) != static_cast<ssize_t>(text.size()))
+            {
+                std::cerr << "Erro: não foi possível gravar a entrada de " << bench.name << ".\n";
+                if (input_fd >= 0)
+                    close(input_fd);
+                result.status = -1;
+                return result;
+            }
+        }
+
+        std::vector<double> times;
+        for (int k = 0; k < opt.runs; ++k)
+        {
+            Run run = run_once(opt, program, input_fd);
+            if (run.status != 0)
+            {
+                std::cerr << "Erro: " << bench.name << " terminou com código " << run.status << ":\n" << run.errors;
+                result.status = run.status;
+                break;
+            }
+            times.push_back(run.ms);
+            result.peak_rss_kb = std::max(result.peak_rss_kb, run.peak_rss_kb);
+            parse_allocations(run.errors, result);
+        }
+        if (input_fd >= 0)
+            close(input_fd);
+
+        if (!times.empty())
+        {
+            std::sort(times.begin(), times.end());
+            std::size_t mid = times.size() / 2;
+            result.median_ms = times.size() % 2 ? times[mid] : (times[mid - 1] + times[mid]) / 2;
+            result.min_ms = times.front();
+            result.max_ms = times.back();
+        }
+        return result;
+    }
+
+    void write_json(std::ostream &os, const Options &opt, const std::vector<Result> &results)
+    {
+        os << "{\n  \"lang\": \"" << opt.lang << "\",\n  \"directive\": \"" << opt.directive
+           << "\",\n  \"runs\": " << opt.runs << ",\n  \"benchmarks\": {\n";
+        char line[512];
+        for (std::size_t k = 0; k < results.size(); ++k)
+        {
+            const Result &r = results[k];
+            std::snprintf(line, sizeof line,
+                          "    \"%s\": {\"median_ms\": %.3f, \"min_ms\": %.3f, \"max_ms\": %.3f, "
+                          "\"peak_rss_kb\": %ld, \"objects_allocated\": %lld, \"bytes_allocated\": %lld, "
+                          "\"status\": %d}%s\n",
+                          r.name.c_str(), r.median_ms, r.min_ms, r.max_ms, r.peak_rss_kb,
+                          r.objects_allocated, r.bytes_allocated, r.status,
+                          k + 1 < results.size() ? "," : "");
+            os << line;
+        }
+        os << "  }\n}\n";
+    }
+
+    bool starts_with(const std::string &arg, const char *prefix, std::string &value)
+    {
+        std::size_t n = std::strlen(prefix);
+        if (arg.compare(0, n, prefix) != 0)
+            return false;
+        value = arg.substr(n);
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    for (int k = 1; k < argc; ++k)
+    {
+        std::string arg = argv[k], value;
+        if (arg == "--")
+        {
+            opt.extra.assign(argv + k + 1, argv + argc);
+            break;
+        }
+        if (starts_with(arg, "--lang=", value))
+            opt.lang = value;
+        else if (starts_with(arg, "--dir=", value))
+            opt.dir = value;
+        else if (starts_with(arg, "--directive=", value))
+            opt.directive = value;
+        else if (starts_with(arg, "--out=", value))
+            opt.out = value;
+        else if (starts_with(arg, "--runs=", value))
+            opt.runs = std::max(1, std::atoi(value.c_str()));
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            std::cerr << "Erro: opção '" << arg << "' desconhecida.\n";
+            return EXIT_FAILURE;
+        }
+        else
+            opt.filter = arg;
+    }
+
+    std::vector<Result> results;
+    bool failed = false;
+    for (const Benchmark &bench : BENCHMARKS)
+    {
+        if (!opt.filter.empty() && std::string(bench.name).find(opt.filter) == std::string::npos)
+            continue;
+        results.push_back(measure(opt, bench));
+        const Result &r = results.back();
+        failed = failed || r.status != 0;
+        std::fprintf(stderr, "%-12s %10.2f ms (min %.2f, máx %.2f) %8ld KiB %12lld alocações\n",
+                     r.name.c_str(), r.median_ms, r.min_ms, r.max_ms, r.peak_rss_kb, r.objects_allocated);
+    }
+
+    if (opt.out.empty())
+        write_json(std::cout, opt, results);
+    else
+    {
+        std::ofstream file(opt.out);
+        write_json(file, opt, results);
+        if (!file)
+        {
+            std::cerr << "Erro: não foi possível gravar '" << opt.out << "'.\n";
+            return EXIT_FAILURE;
+        }
+        std::cerr << "Resultados em " << opt.out << '\n';
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,244 @@
+// Micro-benchmarks dos caminhos internos do interpretador e do checador.
+//
+// Cada caso é executado em lotes crescentes até somar ao menos
+// MIN_SECONDS; o resultado é a vazão em operações por segundo.
+// Uso: lang_micro_bench [filtro]  (roda só os casos cujo nome contém o filtro)
+
+#include "ast/AST.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "typecheck/Resolver.hpp"
+#include "typecheck/TypeChecker.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double MIN_SECONDS = 0.25;
+
+    struct Case
+    {
+        std::string name;
+        std::function<void(std::size_t)> run; // executa n operações
+    };
+
+    std::vector<Case> &registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    void add(const std::string &name, std::function<void(std::size_t)> run)
+    {
+        registry().push_back({name, std::move(run)});
+    }
+
+    double seconds_for(const Case &c, std::size_t n)
+    {
+        auto start = std::chrono::steady_clock::now();
+        c.run(n);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    void report(const Case &c)
+    {
+        std::size_t n = 1000;
+        double secs = seconds_for(c, n);
+        while (secs < MIN_SECONDS)
+        {
+            n *= secs < MIN_SECONDS / 10 ? 10 : 2;
+            secs = seconds_for(c, n);
+        }
+        double ns = secs * 1e9 / n;
+        std::printf("%-28s %12zu ops %10.2f ns/op %12.2f Mops/s\n",
+                    c.name.c_str(), n, ns, n / secs / 1e6);
+    }
+
+    // Avalia 'expr' n vezes pelo Interpreter, como o executor faz a cada visita.
+    void bench_expr(const std::string &name, Expression *expr)
+    {
+        std::shared_ptr<Expression> owned(expr);
+        add(name, [owned](std::size_t n)
+            {
+                Interpreter itp;
+                for (std::size_t k = 0; k < n; ++k)
+                    owned->accept(&itp);
+            });
+    }
+
+    // Um caso por par operador/tipos, com o nome do operador no fonte.
+    struct Operator
+    {
+        const char *text;
+        char op; // código no BinaryOpNode
+    };
+
+    template <class MakeOperand>
+    void bench_operators(const std::string &types, std::initializer_list<Operator> ops, MakeOperand make)
+    {
+        for (const Operator &o : ops)
+            bench_expr("BinaryOp/" + types + "/" + o.text, new BinaryOpNode(make(0), o.op, make(1)));
+    }
+
+    void register_binary_ops()
+    {
+        const std::initializer_list<Operator> arithmetic{{"+", '+'}, {"-", '-'}, {"*", '*'}, {"/", '/'}};
+        const std::initializer_list<Operator> comparison{{"<", '<'}, {">", '>'}, {"==", '='}, {"!=", 'n'}};
+
+        auto ints = [](int k) -> Expression * { return new IntLiteral(k ? 35 : 7); };
+        bench_operators("Int,Int", arithmetic, ints);
+        bench_operators("Int,Int", {{"%", '%'}}, ints);
+        bench_operators("Int,Int", comparison, ints);
+
+        auto floats = [](int k) -> Expression * { return new FloatLiteralNode(k ? 2.25f : 1.5f); };
+        bench_operators("Float,Float", arithmetic, floats);
+        bench_operators("Float,Float", comparison, floats);
+
+        auto mixed = [](int k) -> Expression *
+        { return k ? static_cast<Expression *>(new FloatLiteralNode(2.25f)) : new IntLiteral(7); };
+        bench_operators("Int,Float", {{"+", '+'}, {"*", '*'}, {"<", '<'}}, mixed);
+
+        auto chars = [](int k) -> Expression * { return new CharLiteralNode(k ? 'b' : 'a'); };
+        bench_operators("Char,Char", {{"==", '='}, {"!=", 'n'}}, chars);
+
+        auto bools = [](int k) -> Expression * { return new BoolLiteralNode(k == 0); };
+        bench_operators("Bool,Bool", {{"&&", '&'}, {"==", '='}}, bools);
+
+        auto nulls = [](int) -> Expression * { return new NullLiteralNode(); };
+        bench_operators("null,null", {{"==", '='}, {"!=", 'n'}}, nulls);
+    }
+
+    // Programa com só `main() { <body> }`, que executa n iterações de
+    // 'loop_body' dentro de 'depth' blocos aninhados, cada um com a sua
+    // variável; o laço usa a do bloco mais externo.
+    ProgramNode *loop_program(std::size_t n, int depth, Command *loop_body)
+    {
+        Symbol x = Symbol::intern("x");
+        Command *inner = new IterateCmdNode(Symbol{}, new IntLiteral(static_cast<int>(n)),
+                                            new BlockCmdNode(new std::vector<Command *>{loop_body}));
+        for (int d = depth; d > 0; --d)
+        {
+            Symbol name = d == 1 ? x : Symbol::intern("v" + std::to_string(d));
+            inner = new BlockCmdNode(new std::vector<Command *>{
+                new VarDeclNode(name, new TypeNode(Primitive::INT)), inner});
+        }
+        auto *main_def = new FunDefNode(Symbol::intern("main"), nullptr, nullptr,
+                                        new BlockCmdNode(new std::vector<Command *>{inner}));
+        return new ProgramNode(new std::vector<Node *>{main_def});
+    }
+
+    // Checagem, resolução de slots e execução, como o executor faz com -i -O0.
+    void run_program(ProgramNode *program)
+    {
+        std::unique_ptr<ProgramNode> owned(program);
+        TypeChecker().check(program);
+        Resolver().resolve(program);
+        InterpreterOptions options;
+        options.max_stack = 1000; // a pilha nativa reservada é proporcional
+        Interpreter(options).interpret(program);
+    }
+
+    // Leitura e escrita de variável (x = x + 1) com x declarada 'depth'
+    // blocos acima do laço. Os nomes já viram slots antes da execução, então
+    // o custo não deve variar com a profundidade.
+    void register_variable_access()
+    {
+        for (int depth : {1, 8, 64})
+        {
+            add("Variable/x=x+1/depth=" + std::to_string(depth), [depth](std::size_t n)
+                {
+                    Symbol x = Symbol::intern("x");
+                    run_program(loop_program(n, depth, new AssignCmdNode(
+                        new VarAccessNode(x), new BinaryOpNode(new VarAccessNode(x), '+', new IntLiteral(1)))));
+                });
+        }
+    }
+
+    // `a = new T[...]`, com o coletor reaproveitando os arrays anteriores.
+    // Com várias dimensões só a externa (a última) é alocada, cheia de null:
+    // create_nested_array não é usado por visit(NewExprNode).
+    void bench_new_array(const std::string &name, Primitive type, std::vector<int> dims)
+    {
+        add("NewArray/" + name, [type, dims](std::size_t n)
+            {
+                auto *sizes = new std::vector<Expression *>;
+                for (int d : dims)
+                    sizes->push_back(d ? static_cast<Expression *>(new IntLiteral(d)) : nullptr);
+                Symbol a = Symbol::intern("a");
+                run_program(loop_program(n, 1, new AssignCmdNode(
+                    new VarAccessNode(a), new NewExprNode(new TypeNode(type), sizes))));
+            });
+    }
+
+    // Matriz size x size como os programas a montam: `a = new Int[][size]`
+    // e depois `a[i] = new Int[size]` para cada linha.
+    void bench_new_matrix(int size)
+    {
+        std::string dim = std::to_string(size);
+        add("NewArray/matriz Int " + dim + "x" + dim, [size](std::size_t n)
+            {
+                Symbol a = Symbol::intern("a"), i = Symbol::intern("i");
+                auto *rows = new AssignCmdNode(
+                    new VarAccessNode(a),
+                    new NewExprNode(new TypeNode(Primitive::INT), new std::vector<Expression *>{nullptr, new IntLiteral(size)}));
+                auto *fill = new IterateCmdNode(i, new IntLiteral(size), new BlockCmdNode(new std::vector<Command *>{
+                    new AssignCmdNode(new ArrayAccessNode(new VarAccessNode(a), new VarAccessNode(i)),
+                                      new NewExprNode(new TypeNode(Primitive::INT), new std::vector<Expression *>{new IntLiteral(size)}))}));
+                run_program(loop_program(n, 1, new BlockCmdNode(new std::vector<Command *>{rows, fill})));
+            });
+    }
+
+    void register_new_arrays()
+    {
+        bench_new_array("Int[1000]", Primitive::INT, {1000});
+        bench_new_array("Int[100000]", Primitive::INT, {100000});
+        bench_new_array("Float[100000]", Primitive::FLOAT, {100000});
+        bench_new_array("Int[][1000]", Primitive::INT, {0, 1000});
+        bench_new_array("Int[][][100000]", Primitive::INT, {0, 0, 100000});
+        bench_new_matrix(100);
+        bench_new_matrix(1000);
+    }
+
+    // Declaração `v :: Int[]...[]` num bloco: TypeChecker::type_from_node
+    // sobre um TypeNode com 'depth' níveis de array (mais abrir e fechar o escopo).
+    void register_type_from_node()
+    {
+        for (int depth : {1, 8, 64, 512})
+        {
+            TypeNode *type = new TypeNode(Primitive::INT);
+            for (int d = 0; d < depth; ++d)
+                type = new TypeNode(type);
+            std::shared_ptr<BlockCmdNode> block(new BlockCmdNode(new std::vector<Command *>{
+                new VarDeclNode(Symbol::intern("v"), type)}));
+            add("TypeChecker/VarDecl/array-depth=" + std::to_string(depth), [block](std::size_t n)
+                {
+                    TypeChecker checker;
+                    for (std::size_t k = 0; k < n; ++k)
+                        block->accept(&checker);
+                });
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+
+    register_binary_ops();
+    register_variable_access();
+    register_new_arrays();
+    register_type_from_node();
+
+    for (const Case &c : registry())
+    {
+        if (!filter || c.name.find(filter) != std::string::npos)
+            report(c);
+    }
+    return 0;
+}
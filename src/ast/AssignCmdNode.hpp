@@ -2,13 +2,25 @@
 #define ASSIGN_CMD_NODE_HPP
 #include "Command.hpp"
 #include "Expression.hpp"
+#include "VarAccessNode.hpp"
+#include "FieldAccessNode.hpp"
+#include "ArrayAccessNode.hpp"
 #include "Visitor.hpp"
 class AssignCmdNode : public Command {
 public:
+    // Forma do lado esquerdo, decidida uma vez na construção do nó.
+    enum class Target { VARIABLE, FIELD, ELEMENT, OTHER };
     Expression* lvalue;
     Expression* expr;
-    AssignCmdNode(Expression* l, Expression* e) : lvalue(l), expr(e) {}
+    Target target;
+    AssignCmdNode(Expression* l, Expression* e) : lvalue(l), expr(e), target(classify(l)) {}
     ~AssignCmdNode() { delete lvalue; delete expr; }
     void accept(Visitor* v) override { v->visit(this); }
+    static Target classify(Expression* l) {
+        if (dynamic_cast<VarAccessNode*>(l)) return Target::VARIABLE;
+        if (dynamic_cast<FieldAccessNode*>(l)) return Target::FIELD;
+        if (dynamic_cast<ArrayAccessNode*>(l)) return Target::ELEMENT;
+        return Target::OTHER;
+    }
 };
-#endif
\ No newline at end of file
+#endif
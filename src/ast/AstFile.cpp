@@ -0,0 +1,777 @@
+#include "AstFile.hpp"
+#include "AST.hpp"
+#include "../runtime/BinaryIO.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'L', 'A', 'N', 'G', 'A', 'S', 'T', '\0'};
+    // Cabeçalho: assinatura, versão, tamanho de um nó e soma do conteúdo.
+    constexpr std::size_t HEADER_SIZE = sizeof MAGIC + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    enum class NodeKind : std::uint8_t
+    {
+        PROGRAM, DATA_DEF, FUN_DEF, TYPE, BLOCK, FUN_CALL, FUN_CALL_CMD, NEW_EXPR,
+        FIELD_ACCESS, ARRAY_ACCESS, PRINT, READ, RETURN, VAR_DECL, ASSIGN, IF,
+        ITERATE, INT, FLOAT, CHAR, BOOL, VAR_ACCESS, UNARY, BINARY, NULL_LITERAL
+    };
+
+    // Bits de PackedNode::flags.
+    enum : std::uint8_t
+    {
+        PURE = 1,
+        MEMOIZABLE = 2,
+        TAIL_CALL = 4,
+        FRAME_LOCAL = 8,
+        DECLARES = 16,
+        IS_PRIMITIVE = 32,
+        IS_ARRAY = 64,
+        OVER_ARRAY = 128
+    };
+
+    constexpr std::int32_t NONE = -1; // filho ausente, função não resolvida
+
+    // Um nó no arquivo. Os filhos sempre vêm antes do pai (pós-ordem), e a
+    // raiz é o último nó. Listas são posições no vetor 'words' (quantidade
+    // seguida dos índices); nomes são posições na tabela de nomes.
+    //
+    //   PROGRAM       a: lista de definições
+    //   DATA_DEF      a: nome, b: lista de campos (VAR_DECL)
+    //   FUN_DEF       a: nome, b: corpo, c: frame_size, d: quantidade de
+    //                 parâmetros, pares (nome, tipo) e a lista de retornos
+    //   TYPE          op: Primitive, a: nome do registro, b: tipo do elemento
+    //   BLOCK         a: lista de comandos
+    //   FUN_CALL      a: nome, b: FUN_DEF chamada, c: argumentos, d: índice do retorno
+    //   FUN_CALL_CMD  a: nome, b: FUN_DEF chamada, c: argumentos, d: lvalues
+    //   NEW_EXPR      a: tipo base, b: dimensões (podem ser NONE)
+    //   FIELD_ACCESS  a: registro, b: nome do campo, c: field_slot
+    //   ARRAY_ACCESS  a: array, b: índice
+    //   PRINT         a: expressão
+    //   READ          a: lvalue, op: declared_type, spec: target_type
+    //   RETURN        a: lista de expressões
+    //   VAR_DECL      a: nome, b: tipo, c: slot
+    //   ASSIGN        a: lvalue, b: expressão
+    //   IF            a: condição, b: então, c: senão (ou NONE)
+    //   ITERATE       a: variável (nome vazio em iterate(n)), b: condição, c: corpo, d: loop_slot;
+    //                 OVER_ARRAY se percorre os elementos de um array
+    //   INT, FLOAT    a: valor (os bits, no FLOAT)
+    //   CHAR, BOOL    op: valor
+    //   VAR_ACCESS    a: nome, b: slot
+    //   UNARY         op, spec: UnarySpec, a: operando
+    //   BINARY        op, spec: BinarySpec, a: esquerda, b: direita
+    struct PackedNode
+    {
+        NodeKind kind;
+        std::uint8_t op;
+        std::uint8_t spec;
+        std::uint8_t flags;
+        SourceLoc loc; // 'file' é a posição na tabela de arquivos do .lbin
+        std::int32_t a, b, c, d;
+    };
+    static_assert(sizeof(PackedNode) == 28, "PackedNode faz parte do formato do arquivo");
+
+    // Percorre a AST em pós-ordem e monta as tabelas do arquivo.
+    class Encoder : public Visitor
+    {
+    public:
+        std::vector<PackedNode> nodes;
+        std::vector<std::int32_t> words;
+        std::vector<Symbol> names{Symbol{}}; // o nome 0 é o vazio
+        std::vector<std::uint16_t> files{0}; // números de SourceLoc::file; o 0 é "sem arquivo"
+
+        void encode(ProgramNode *ast)
+        {
+            node(ast);
+            // Só agora todas as funções têm índice (uma chamada pode vir antes da definição).
+            for (const auto &call : calls)
+            {
+                auto it = function_index.find(call.second);
+                nodes[call.first].b = it != function_index.end() ? it->second : NONE;
+            }
+        }
+
+        void visit(ProgramNode *node) override
+        {
+            std::int32_t definitions = list(node->definitions);
+            emit(node, NodeKind::PROGRAM).a = definitions;
+        }
+
+        void visit(DataDefNode *node) override
+        {
+            std::int32_t fields = list(node->fields);
+            PackedNode &p = emit(node, NodeKind::DATA_DEF);
+            p.a = name(node->name);
+            p.b = fields;
+        }
+
+        void visit(FunDefNode *node) override
+        {
+            std::vector<std::int32_t> params;
+            for (const FunDefNode::Param &param : node->params)
+            {
+                std::int32_t type = this->node(param.type);
+                params.push_back(name(param.name));
+                params.push_back(type);
+            }
+            std::vector<std::int32_t> returns;
+            for (TypeNode *type : node->return_types)
+                returns.push_back(this->node(type));
+            std::int32_t body = this->node(node->body);
+
+            std::int32_t signature = static_cast<std::int32_t>(words.size());
+            words.push_back(static_cast<std::int32_t>(node->params.size()));
+            words.insert(words.end(), params.begin(), params.end());
+            append(returns);
+
+            PackedNode &p = emit(node, NodeKind::FUN_DEF);
+            p.a = name(node->name);
+            p.b = body;
+            p.c = node->frame_size;
+            p.d = signature;
+            p.flags = (node->pure ? PURE : 0) | (node->memoizable ? MEMOIZABLE : 0);
+            function_index[node] = last;
+        }
+
+        void visit(TypeNode *node) override
+        {
+            std::int32_t element = this->node(node->element_type);
+            PackedNode &p = emit(node, NodeKind::TYPE);
+            p.op = static_cast<std::uint8_t>(node->p_type);
+            p.a = name(node->user_type_name);
+            p.b = element;
+            p.flags = (node->is_primitive ? IS_PRIMITIVE : 0) | (node->is_array ? IS_ARRAY : 0);
+        }
+
+        void visit(BlockCmdNode *node) override
+        {
+            std::int32_t commands = list(node->commands);
+            emit(node, NodeKind::BLOCK).a = commands;
+        }
+
+        void visit(FunCallNode *node) override
+        {
+            std::int32_t args = list(node->args);
+            std::int32_t index = this->node(node->return_index);
+            PackedNode &p = emit(node, NodeKind::FUN_CALL);
+            p.a = name(node->name);
+            p.b = NONE;
+            p.c = args;
+            p.d = index;
+            calls.emplace_back(last, node->target);
+        }
+
+        void visit(FunCallCmdNode *node) override
+        {
+            std::int32_t args = list(node->args);
+            std::int32_t lvalues = list(node->lvalues);
+            PackedNode &p = emit(node, NodeKind::FUN_CALL_CMD);
+            p.a = name(node->name);
+            p.b = NONE;
+            p.c = args;
+            p.d = lvalues;
+            calls.emplace_back(last, node->target);
+        }
+
+        void visit(NewExprNode *node) override
+        {
+            std::int32_t base = this->node(node->base_type);
+            std::int32_t dims = list(node->dims);
+            PackedNode &p = emit(node, NodeKind::NEW_EXPR);
+            p.a = base;
+            p.b = dims;
+            p.flags = node->frame_local ? FRAME_LOCAL : 0;
+        }
+
+        void visit(FieldAccessNode *node) override
+        {
+            std::int32_t record = this->node(node->record_expr);
+            PackedNode &p = emit(node, NodeKind::FIELD_ACCESS);
+            p.a = record;
+            p.b = name(node->field_name);
+            p.c = node->field_slot;
+        }
+
+        void visit(ArrayAccessNode *node) override
+        {
+            std::int32_t array = this->node(node->array_expr);
+            std::int32_t index = this->node(node->index_expr);
+            PackedNode &p = emit(node, NodeKind::ARRAY_ACCESS);
+            p.a = array;
+            p.b = index;
+        }
+
+        void visit(PrintCmd *node) override
+        {
+            std::int32_t expr = this->node(node->expr);
+            emit(node, NodeKind::PRINT).a = expr;
+        }
+
+        void visit(ReadCmdNode *node) override
+        {
+            std::int32_t lvalue = this->node(node->lvalue);
+            PackedNode &p = emit(node, NodeKind::READ);
+            p.a = lvalue;
+            p.op = static_cast<std::uint8_t>(node->declared_type);
+            p.spec = static_cast<std::uint8_t>(node->target_type);
+            p.flags = node->declares ? DECLARES : 0;
+        }
+
+        void visit(ReturnCmdNode *node) override
+        {
+            std::int32_t expressions = list(node->expressions);
+            PackedNode &p = emit(node, NodeKind::RETURN);
+            p.a = expressions;
+            p.flags = node->tail_call ? TAIL_CALL : 0;
+        }
+
+        void visit(VarDeclNode *node) override
+        {
+            std::int32_t type = this->node(node->type);
+            PackedNode &p = emit(node, NodeKind::VAR_DECL);
+            p.a = name(node->name);
+            p.b = type;
+            p.c = node->slot;
+            p.flags = node->frame_local ? FRAME_LOCAL : 0;
+        }
+
+        void visit(AssignCmdNode *node) override
+        {
+            std::int32_t lvalue = this->node(node->lvalue);
+            std::int32_t expr = this->node(node->expr);
+            PackedNode &p = emit(node, NodeKind::ASSIGN);
+            p.a = lvalue;
+            p.b = expr;
+        }
+
+        void visit(IfCmdNode *node) override
+        {
+            std::int32_t condition = this->node(node->condition);
+            std::int32_t then_branch = this->node(node->then_branch);
+            std::int32_t else_branch = this->node(node->else_branch);
+            PackedNode &p = emit(node, NodeKind::IF);
+            p.a = condition;
+            p.b = then_branch;
+            p.c = else_branch;
+        }
+
+        void visit(IterateCmdNode *node) override
+        {
+            std::int32_t condition = this->node(node->condition);
+            std::int32_t body = this->node(node->body);
+            PackedNode &p = emit(node, NodeKind::ITERATE);
+            p.a = name(node->loop_variable);
+            p.b = condition;
+            p.c = body;
+            p.d = node->loop_slot;
+            p.flags = node->over_array ? OVER_ARRAY : 0;
+        }
+
+        void visit(IntLiteral *node) override { emit(node, NodeKind::INT).a = node->value; }
+        void visit(FloatLiteralNode *node) override
+        {
+            std::memcpy(&emit(node, NodeKind::FLOAT).a, &node->value, sizeof node->value);
+        }
+        void visit(CharLiteralNode *node) override { emit(node, NodeKind::CHAR).op = static_cast<std::uint8_t>(node->value); }
+        void visit(BoolLiteralNode *node) override { emit(node, NodeKind::BOOL).op = node->value ? 1 : 0; }
+        void visit(NullLiteralNode *node) override { emit(node, NodeKind::NULL_LITERAL); }
+
+        void visit(VarAccessNode *node) override
+        {
+            PackedNode &p = emit(node, NodeKind::VAR_ACCESS);
+            p.a = name(node->name);
+            p.b = node->slot;
+        }
+
+        void visit(UnaryOpNode *node) override
+        {
+            std::int32_t expr = this->node(node->expr);
+            PackedNode &p = emit(node, NodeKind::UNARY);
+            p.op = static_cast<std::uint8_t>(node->op);
+            p.spec = static_cast<std::uint8_t>(node->spec);
+            p.a = expr;
+        }
+
+        void visit(BinaryOpNode *node) override
+        {
+            std::int32_t left = this->node(node->left);
+            std::int32_t right = this->node(node->right);
+            PackedNode &p = emit(node, NodeKind::BINARY);
+            p.op = static_cast<std::uint8_t>(node->op);
+            p.spec = static_cast<std::uint8_t>(node->spec);
+            p.a = left;
+            p.b = right;
+        }
+
+    private:
+        std::int32_t last = NONE; // índice do último nó emitido
+        std::vector<std::int32_t> name_index; // por id do símbolo
+        std::vector<std::uint16_t> file_index; // por número de arquivo
+        std::unordered_map<const FunDefNode *, std::int32_t> function_index;
+        std::vector<std::pair<std::int32_t, const FunDefNode *>> calls; // nó da chamada, função chamada
+
+        std::int32_t node(Node *n)
+        {
+            if (!n)
+                return NONE;
+            n->accept(this);
+            return last;
+        }
+
+        template <typename T>
+        std::int32_t list(const std::vector<T *> &items)
+        {
+            std::vector<std::int32_t> indices;
+            for (T *item : items)
+                indices.push_back(node(item));
+            return append(indices);
+        }
+
+        std::int32_t append(const std::vector<std::int32_t> &items)
+        {
+            std::int32_t offset = static_cast<std::int32_t>(words.size());
+            words.push_back(static_cast<std::int32_t>(items.size()));
+            words.insert(words.end(), items.begin(), items.end());
+            return offset;
+        }
+
+        std::int32_t name(Symbol s)
+        {
+            if (s.empty())
+                return 0;
+            if (s.id >= name_index.size())
+                name_index.resize(s.id + 1, 0);
+            std::int32_t &index = name_index[s.id];
+            if (index == 0)
+            {
+                index = static_cast<std::int32_t>(names.size());
+                names.push_back(s);
+            }
+            return index;
+        }
+
+        std::uint16_t file(std::uint16_t f)
+        {
+            if (f == 0)
+                return 0;
+            if (f >= file_index.size())
+                file_index.resize(f + 1, 0);
+            std::uint16_t &index = file_index[f];
+            if (index == 0)
+            {
+                index = static_cast<std::uint16_t>(files.size());
+                files.push_back(f);
+            }
+            return index;
+        }
+
+        // Os filhos já foram emitidos: a referência devolvida vale até o próximo emit.
+        PackedNode &emit(Node *n, NodeKind kind)
+        {
+            PackedNode p{};
+            p.kind = kind;
+            p.loc = n->loc;
+            p.loc.file = file(n->loc.file);
+            nodes.push_back(p);
+            last = static_cast<std::int32_t>(nodes.size() - 1);
+            return nodes.back();
+        }
+    };
+
+    // Reconstrói os nós a partir das tabelas mapeadas, numa passada só. Cada
+    // nó precisa ser filho de exatamente um nó posterior; assim o resultado é
+    // uma árvore, mesmo que o arquivo tenha sido adulterado.
+    class Decoder
+    {
+    public:
+        Decoder(const char *packed, std::size_t node_count, const char *words, std::size_t word_count,
+                const std::vector<Symbol> &names, const std::vector<std::uint16_t> &files)
+            : packed(packed), node_count(node_count), words(words), word_count(word_count),
+              names(names), files(files), built(node_count, nullptr), claimed(node_count, false) {}
+
+        ProgramNode *decode()
+        {
+            for (std::size_t i = 0; i < node_count && ok; ++i)
+            {
+                PackedNode p;
+                std::memcpy(&p, packed + i * sizeof p, sizeof p);
+                current = i;
+                if (p.loc.file >= files.size())
+                    ok = false;
+                Node *n = build(p);
+                if (!n)
+                    break;
+                n->loc = p.loc;
+                n->loc.file = p.loc.file < files.size() ? files[p.loc.file] : 0;
+                built[i] = n;
+            }
+
+            ProgramNode *root = ok && node_count > 0 ? dynamic_cast<ProgramNode *>(built[node_count - 1]) : nullptr;
+            ok = ok && root && max_field_slot < max_fields;
+            for (std::size_t i = 0; ok && i + 1 < node_count; ++i)
+                ok = claimed[i];
+            for (const auto &call : calls)
+            {
+                if (!ok)
+                    break;
+                if (call.second == NONE)
+                    continue;
+                FunDefNode *target = call.second >= 0 && static_cast<std::size_t>(call.second) < node_count
+                                         ? dynamic_cast<FunDefNode *>(built[call.second])
+                                         : nullptr;
+                ok = target != nullptr;
+                if (auto *fc = dynamic_cast<FunCallNode *>(call.first))
+                    fc->target = target;
+                else
+                    static_cast<FunCallCmdNode *>(call.first)->target = target;
+            }
+            if (ok)
+                return root;
+
+            // Os nós sem pai são raízes das subárvores já montadas.
+            for (std::size_t i = 0; i < node_count; ++i)
+                if (built[i] && !claimed[i])
+                    delete built[i];
+            return nullptr;
+        }
+
+    private:
+        const char *packed;
+        std::size_t node_count;
+        const char *words;
+        std::size_t word_count;
+        const std::vector<Symbol> &names;
+        const std::vector<std::uint16_t> &files;
+        std::vector<Node *> built;
+        std::vector<bool> claimed;
+        std::vector<std::pair<Node *, std::int32_t>> calls; // chamada, índice da FUN_DEF
+        std::size_t current = 0;
+        bool ok = true;
+        // Slots usados desde a última definição, conferidos com o frame_size
+        // da função (os nós do corpo vêm logo antes dela).
+        std::int32_t max_slot = -1;
+        bool unresolved_decl = false;
+        std::int32_t max_field_slot = -1;
+        std::int32_t max_fields = 0;
+
+        std::int32_t word(std::int64_t pos)
+        {
+            if (pos < 0 || static_cast<std::uint64_t>(pos) >= word_count)
+            {
+                ok = false;
+                return 0;
+            }
+            std::int32_t v;
+            std::memcpy(&v, words + pos * sizeof v, sizeof v);
+            return v;
+        }
+
+        template <typename T>
+        T *take(std::int32_t index, bool optional = false)
+        {
+            if (index == NONE && optional)
+                return nullptr;
+            T *n = index >= 0 && static_cast<std::size_t>(index) < current && !claimed[index]
+                       ? dynamic_cast<T *>(built[index])
+                       : nullptr;
+            if (!n)
+            {
+                ok = false;
+                return nullptr;
+            }
+            claimed[index] = true;
+            return n;
+        }
+
+        // O vetor é entregue ao construtor do nó, que o apaga.
+        template <typename T>
+        std::vector<T *> *list(std::int32_t offset, bool optional = false)
+        {
+            auto *items = new std::vector<T *>;
+            std::int32_t count = word(offset);
+            if (count < 0 || static_cast<std::size_t>(count) > word_count)
+            {
+                ok = false;
+                return items;
+            }
+            for (std::int32_t i = 0; i < count && ok; ++i)
+                items->push_back(take<T>(word(static_cast<std::int64_t>(offset) + 1 + i), optional));
+            return items;
+        }
+
+        Symbol name(std::int32_t index)
+        {
+            if (index < 0 || static_cast<std::size_t>(index) >= names.size())
+            {
+                ok = false;
+                return Symbol{};
+            }
+            return names[index];
+        }
+
+        std::int32_t slot(std::int32_t s)
+        {
+            if (s < -1)
+                ok = false;
+            max_slot = std::max(max_slot, s);
+            return s;
+        }
+
+        void check(bool condition) { ok = ok && condition; }
+
+        // Sempre devolve um nó (com filhos nulos se algo falhou), para que a
+        // posse dos nós já montados continue clara; nullptr só para tipo desconhecido.
+        Node *build(const PackedNode &p)
+        {
+            switch (p.kind)
+            {
+            case NodeKind::PROGRAM:
+            {
+                auto *program = new ProgramNode(list<Node>(p.a));
+                for (Node *def : program->definitions)
+                    check(dynamic_cast<FunDefNode *>(def) || dynamic_cast<DataDefNode *>(def));
+                return program;
+            }
+            case NodeKind::DATA_DEF:
+            {
+                auto *def = new DataDefNode(name(p.a), list<VarDeclNode>(p.b));
+                max_fields = std::max(max_fields, static_cast<std::int32_t>(def->fields.size()));
+                max_slot = -1;
+                unresolved_decl = false;
+                return def;
+            }
+            case NodeKind::FUN_DEF:
+            {
+                auto *params = new std::vector<FunDefNode::Param>;
+                std::int32_t count = word(p.d);
+                check(count >= 0 && static_cast<std::size_t>(count) <= word_count);
+                std::int64_t pos = static_cast<std::int64_t>(p.d) + 1;
+                for (std::int32_t i = 0; i < count && ok; ++i, pos += 2)
+                {
+                    Symbol param = name(word(pos));
+                    params->push_back(FunDefNode::Param{param, take<TypeNode>(word(pos + 1))});
+                }
+                auto *returns = list<TypeNode>(ok ? static_cast<std::int32_t>(pos) : 0);
+                auto *fn = new FunDefNode(name(p.a), params, returns, take<BlockCmdNode>(p.b));
+                fn->frame_size = p.c;
+                fn->pure = p.flags & PURE;
+                fn->memoizable = p.flags & MEMOIZABLE;
+                check(p.c >= 0 && max_slot < p.c && !unresolved_decl);
+                max_slot = -1;
+                unresolved_decl = false;
+                return fn;
+            }
+            case NodeKind::TYPE:
+            {
+                check(p.op <= static_cast<std::uint8_t>(Primitive::VOID));
+                TypeNode *type;
+                if (p.flags & IS_ARRAY)
+                    type = new TypeNode(take<TypeNode>(p.b));
+                else if (p.flags & IS_PRIMITIVE)
+                    type = new TypeNode(static_cast<Primitive>(p.op));
+                else
+                    type = new TypeNode(name(p.a));
+                return type;
+            }
+            case NodeKind::BLOCK:
+                return new BlockCmdNode(list<Command>(p.a));
+            case NodeKind::FUN_CALL:
+            {
+                auto *args = list<Expression>(p.c);
+                auto *call = new FunCallNode(name(p.a), args, take<Expression>(p.d));
+                calls.emplace_back(call, p.b);
+                return call;
+            }
+            case NodeKind::FUN_CALL_CMD:
+            {
+                auto *args = list<Expression>(p.c);
+                auto *call = new FunCallCmdNode(name(p.a), args, list<Expression>(p.d));
+                calls.emplace_back(call, p.b);
+                return call;
+            }
+            case NodeKind::NEW_EXPR:
+            {
+                TypeNode *base = take<TypeNode>(p.a);
+                auto *expr = new NewExprNode(base, list<Expression>(p.b, true));
+                expr->frame_local = p.flags & FRAME_LOCAL;
+                return expr;
+            }
+            case NodeKind::FIELD_ACCESS:
+            {
+                auto *access = new FieldAccessNode(take<Expression>(p.a), name(p.b));
+                access->field_slot = p.c;
+                check(p.c >= -1);
+                max_field_slot = std::max(max_field_slot, p.c);
+                return access;
+            }
+            case NodeKind::ARRAY_ACCESS:
+            {
+                Expression *array = take<Expression>(p.a);
+                return new ArrayAccessNode(array, take<Expression>(p.b));
+            }
+            case NodeKind::PRINT:
+                return new PrintCmd(take<Expression>(p.a));
+            case NodeKind::READ:
+            {
+                check(p.op <= static_cast<std::uint8_t>(Primitive::VOID) &&
+                      p.spec <= static_cast<std::uint8_t>(Primitive::VOID));
+                auto *read = new ReadCmdNode(take<Expression>(p.a));
+                read->declares = p.flags & DECLARES;
+                read->declared_type = static_cast<Primitive>(p.op);
+                read->target_type = static_cast<Primitive>(p.spec);
+                return read;
+            }
+            case NodeKind::RETURN:
+            {
+                auto *ret = new ReturnCmdNode(list<Expression>(p.a));
+                ret->tail_call = p.flags & TAIL_CALL;
+                return ret;
+            }
+            case NodeKind::VAR_DECL:
+            {
+                auto *decl = new VarDeclNode(name(p.a), take<TypeNode>(p.b));
+                decl->slot = slot(p.c);
+                decl->frame_local = p.flags & FRAME_LOCAL;
+                unresolved_decl = unresolved_decl || p.c < 0;
+                return decl;
+            }
+            case NodeKind::ASSIGN:
+            {
+                Expression *lvalue = take<Expression>(p.a);
+                return new AssignCmdNode(lvalue, take<Expression>(p.b));
+            }
+            case NodeKind::IF:
+            {
+                Expression *condition = take<Expression>(p.a);
+                Command *then_branch = take<Command>(p.b);
+                return new IfCmdNode(condition, then_branch, take<Command>(p.c, true));
+            }
+            case NodeKind::ITERATE:
+            {
+                Expression *condition = take<Expression>(p.b);
+                auto *loop = new IterateCmdNode(name(p.a), condition, take<Command>(p.c));
+                loop->loop_slot = slot(p.d);
+                loop->over_array = p.flags & OVER_ARRAY;
+                return loop;
+            }
+            case NodeKind::INT:
+                return new IntLiteral(p.a);
+            case NodeKind::FLOAT:
+            {
+                float value;
+                std::memcpy(&value, &p.a, sizeof value);
+                return new FloatLiteralNode(value);
+            }
+            case NodeKind::CHAR:
+                return new CharLiteralNode(static_cast<char>(p.op));
+            case NodeKind::BOOL:
+                return new BoolLiteralNode(p.op != 0);
+            case NodeKind::NULL_LITERAL:
+                return new NullLiteralNode();
+            case NodeKind::VAR_ACCESS:
+            {
+                auto *var = new VarAccessNode(name(p.a));
+                var->slot = slot(p.b);
+                return var;
+            }
+            case NodeKind::UNARY:
+            {
+                check(p.spec <= static_cast<std::uint8_t>(UnarySpec::BOOL_NOT));
+                auto *unary = new UnaryOpNode(static_cast<char>(p.op), take<Expression>(p.a));
+                unary->spec = static_cast<UnarySpec>(p.spec);
+                return unary;
+            }
+            case NodeKind::BINARY:
+            {
+                check(p.spec <= static_cast<std::uint8_t>(BinarySpec::BOOL_AND));
+                Expression *left = take<Expression>(p.a);
+                auto *binary = new BinaryOpNode(left, static_cast<char>(p.op), take<Expression>(p.b));
+                binary->spec = static_cast<BinarySpec>(p.spec);
+                return binary;
+            }
+            }
+            ok = false;
+            return nullptr;
+        }
+    };
+
+    // Tamanho mínimo de um texto no arquivo, para limitar as contagens lidas.
+    constexpr std::size_t MIN_STRING = sizeof(std::uint32_t);
+}
+
+bool AstFile::is_ast_file(const char *begin, const char *end)
+{
+    return static_cast<std::size_t>(end - begin) >= sizeof MAGIC && std::memcmp(begin, MAGIC, sizeof MAGIC) == 0;
+}
+
+bool AstFile::store(const std::string &path, ProgramNode *ast)
+{
+    Encoder encoder;
+    encoder.encode(ast);
+
+    // Os nós vêm primeiro, logo depois do cabeçalho, alinhados para leitura no lugar.
+    BinaryWriter w;
+    w.u32(static_cast<std::uint32_t>(encoder.nodes.size()));
+    w.raw(encoder.nodes.data(), encoder.nodes.size() * sizeof(PackedNode));
+    w.u32(static_cast<std::uint32_t>(encoder.words.size()));
+    w.raw(encoder.words.data(), encoder.words.size() * sizeof(std::int32_t));
+    w.u32(static_cast<std::uint32_t>(encoder.names.size()));
+    for (Symbol name : encoder.names)
+        w.str(name.str());
+    w.u32(static_cast<std::uint32_t>(encoder.files.size()));
+    for (std::uint16_t file : encoder.files)
+        w.str(source_file_name(file));
+
+    BinaryWriter header;
+    header.raw(MAGIC, sizeof MAGIC);
+    header.u32(AST_FILE_VERSION);
+    header.u32(sizeof(PackedNode));
+    header.u64(fnv1a(FNV_OFFSET, w.data().data(), w.data().size()));
+
+    std::FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        return false;
+    const std::string &body = w.data();
+    bool written = std::fwrite(header.data().data(), 1, HEADER_SIZE, out) == HEADER_SIZE &&
+                   std::fwrite(body.data(), 1, body.size(), out) == body.size();
+    written = std::fclose(out) == 0 && written;
+    if (!written)
+        std::remove(path.c_str());
+    return written;
+}
+
+ProgramNode *AstFile::load(const char *begin, const char *end)
+{
+    if (!is_ast_file(begin, end))
+        return nullptr;
+    BinaryReader r(begin + sizeof MAGIC, end);
+    if (r.u32() != AST_FILE_VERSION || r.u32() != sizeof(PackedNode))
+        return nullptr;
+    std::uint64_t checksum = r.u64();
+    if (!r.ok || checksum != fnv1a(FNV_OFFSET, begin + HEADER_SIZE, end - begin - HEADER_SIZE))
+        return nullptr;
+
+    std::size_t node_count = r.count(sizeof(PackedNode));
+    const char *packed = r.skip(node_count * sizeof(PackedNode));
+    std::size_t word_count = r.count(sizeof(std::int32_t));
+    const char *words = r.skip(word_count * sizeof(std::int32_t));
+
+    std::vector<Symbol> names(r.count(MIN_STRING));
+    for (Symbol &name : names)
+        name = Symbol::intern(r.view());
+    // Os arquivos-fonte ganham números novos neste processo.
+    std::vector<std::uint16_t> files(r.count(MIN_STRING));
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::string path = r.str();
+        files[i] = i == 0 ? 0 : register_source_file(path);
+    }
+    if (!r.ok || !r.at_end() || names.empty() || !names[0].empty() || files.empty())
+        return nullptr;
+
+    return Decoder(packed, node_count, words, word_count, names, files).decode();
+}
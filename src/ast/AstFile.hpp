@@ -0,0 +1,39 @@
+#ifndef AST_FILE_HPP
+#define AST_FILE_HPP
+
+#include <cstdint>
+#include <string>
+
+class ProgramNode;
+
+// AST serializada (.lbin): `lang -emit-ast saida.lbin prog.lang` grava e
+// `lang -i saida.lbin` (ou -vm) executa.
+//
+// O arquivo guarda a AST depois da análise, com as anotações de cada passo
+// (slots, especializações, chamadas resolvidas, escape e pureza), então
+// carregá-lo pula o lexer, o parser, o TypeChecker e os otimizadores; o
+// nível -O é o da geração.
+//
+// O formato é plano: uma tabela de nós de tamanho fixo em pós-ordem, que se
+// referem uns aos outros por índice, um vetor de inteiros com as listas de
+// filhos e uma tabela de nomes. O arquivo é mapeado em memória (SourceFile)
+// e lido no lugar, sem etapa de decodificação: cada registro vira um nó
+// numa só passada e os nomes vão direto do mapeamento para a tabela de
+// símbolos. Como no cache de bytecode, os números estão na ordem de bytes
+// nativa.
+class AstFile
+{
+public:
+    // Incremente ao mudar o layout do arquivo ou o significado das anotações.
+    static constexpr std::uint32_t AST_FILE_VERSION = 2;
+
+    // O buffer começa com a assinatura de um .lbin?
+    static bool is_ast_file(const char *begin, const char *end);
+    // 'ast' já deve ter passado pela análise. false em erro de E/S.
+    static bool store(const std::string &path, ProgramNode *ast);
+    // nullptr se o arquivo é de outra versão, está corrompido ou tem
+    // índices que não formam uma árvore válida.
+    static ProgramNode *load(const char *begin, const char *end);
+};
+
+#endif
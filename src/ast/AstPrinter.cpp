@@ -0,0 +1,268 @@
+#include "AstPrinter.hpp"
+#include "AST.hpp"
+
+// Nomes na mesma ordem de BinarySpec/UnarySpec.
+static const char *const BINARY_SPEC_NAMES[] = {
+    "generic",
+    "int+", "int-", "int*", "int/", "int%", "int<", "int>", "int==", "int!=",
+    "float+", "float-", "float*", "float/", "float<", "float>", "float==", "float!=",
+    "char==", "char!=", "bool==", "bool!=", "bool&&"};
+static const char *const UNARY_SPEC_NAMES[] = {"generic", "int-", "float-", "bool!"};
+
+// O parser guarda '==', '!=' e '&&' como um único caractere.
+static std::string op_text(char op)
+{
+    switch (op)
+    {
+    case '=':
+        return "==";
+    case 'n':
+        return "!=";
+    case '&':
+        return "&&";
+    default:
+        return std::string(1, op);
+    }
+}
+
+static std::string primitive_name(Primitive p)
+{
+    switch (p)
+    {
+    case Primitive::INT:
+        return "Int";
+    case Primitive::FLOAT:
+        return "Float";
+    case Primitive::CHAR:
+        return "Char";
+    case Primitive::BOOL:
+        return "Bool";
+    default:
+        return "Void";
+    }
+}
+
+std::string AstPrinter::type_name(TypeNode *type)
+{
+    if (!type)
+        return "?";
+    if (type->is_array)
+        return type_name(type->element_type) + "[]";
+    if (type->is_primitive)
+        return primitive_name(type->p_type);
+    return type->user_type_name;
+}
+
+std::ostream &AstPrinter::line()
+{
+    for (int i = 0; i < depth; ++i)
+        out << "  ";
+    return out;
+}
+
+void AstPrinter::child(Node *node)
+{
+    ++depth;
+    if (node)
+        node->accept(this);
+    else
+        line() << "(vazio)\n";
+    --depth;
+}
+
+void AstPrinter::print(ProgramNode *ast)
+{
+    if (ast)
+        ast->accept(this);
+}
+
+// --- Definições ---
+
+void AstPrinter::visit(ProgramNode *node)
+{
+    line() << "Program\n";
+    for (Node *def : node->definitions)
+        child(def);
+}
+
+void AstPrinter::visit(FunDefNode *node)
+{
+    line() << "Fun " << node->name << '(';
+    for (size_t i = 0; i < node->params.size(); ++i)
+    {
+        if (i > 0)
+            out << ", ";
+        out << node->params[i].name << " :: " << type_name(node->params[i].type);
+    }
+    out << ')';
+    for (size_t i = 0; i < node->return_types.size(); ++i)
+        out << (i == 0 ? " : " : ", ") << type_name(node->return_types[i]);
+    out << "  [frame " << node->frame_size << "]";
+    if (node->pure)
+        out << (node->memoizable ? "  (pura, memoizável)" : "  (pura)");
+    out << '\n';
+    child(node->body);
+}
+
+void AstPrinter::visit(DataDefNode *node)
+{
+    line() << "Data " << node->name << '\n';
+    for (VarDeclNode *field : node->fields)
+        child(field);
+}
+
+void AstPrinter::visit(TypeNode *node)
+{
+    line() << "Type " << type_name(node) << '\n';
+}
+
+// --- Comandos ---
+
+void AstPrinter::visit(BlockCmdNode *node)
+{
+    line() << "Block\n";
+    for (Command *cmd : node->commands)
+        child(cmd);
+}
+
+void AstPrinter::visit(VarDeclNode *node)
+{
+    line() << "Decl " << node->name << " :: " << type_name(node->type);
+    if (node->slot >= 0)
+        out << "  @" << node->slot;
+    if (node->frame_local)
+        out << "  (local)";
+    out << '\n';
+}
+
+void AstPrinter::visit(AssignCmdNode *node)
+{
+    line() << "Assign\n";
+    child(node->lvalue);
+    child(node->expr);
+}
+
+void AstPrinter::visit(PrintCmd *node)
+{
+    line() << "Print\n";
+    child(node->expr);
+}
+
+void AstPrinter::visit(ReadCmdNode *node)
+{
+    line() << "Read";
+    if (node->declares)
+        out << "  (declara " << primitive_name(node->declared_type) << ')';
+    out << '\n';
+    child(node->lvalue);
+}
+
+void AstPrinter::visit(ReturnCmdNode *node)
+{
+    line() << (node->tail_call ? "Return  (cauda)\n" : "Return\n");
+    for (Expression *expr : node->expressions)
+        child(expr);
+}
+
+void AstPrinter::visit(IfCmdNode *node)
+{
+    line() << "If\n";
+    child(node->condition);
+    child(node->then_branch);
+    if (node->else_branch)
+    {
+        line() << "Else\n";
+        child(node->else_branch);
+    }
+}
+
+void AstPrinter::visit(IterateCmdNode *node)
+{
+    line() << "Iterate";
+    if (!node->loop_variable.empty())
+    {
+        out << ' ' << node->loop_variable;
+        if (node->loop_slot >= 0)
+            out << "  @" << node->loop_slot;
+    }
+    out << (node->over_array ? "  (array)\n" : "\n");
+    child(node->condition);
+    child(node->body);
+}
+
+void AstPrinter::visit(FunCallCmdNode *node)
+{
+    line() << "CallCmd " << node->name << '\n';
+    for (Expression *arg : node->args)
+        child(arg);
+    if (!node->lvalues.empty())
+    {
+        line() << "Into\n";
+        for (Expression *lval : node->lvalues)
+            child(lval);
+    }
+}
+
+// --- Expressões ---
+
+void AstPrinter::visit(FunCallNode *node)
+{
+    line() << "Call " << node->name << '\n';
+    for (Expression *arg : node->args)
+        child(arg);
+    line() << "Index\n";
+    child(node->return_index);
+}
+
+void AstPrinter::visit(NewExprNode *node)
+{
+    line() << "New " << type_name(node->base_type) << (node->frame_local ? "  (local)\n" : "\n");
+    for (Expression *dim : node->dims)
+        child(dim);
+}
+
+void AstPrinter::visit(FieldAccessNode *node)
+{
+    line() << "Field ." << node->field_name << '\n';
+    child(node->record_expr);
+}
+
+void AstPrinter::visit(ArrayAccessNode *node)
+{
+    line() << "Index\n";
+    child(node->array_expr);
+    child(node->index_expr);
+}
+
+void AstPrinter::visit(UnaryOpNode *node)
+{
+    line() << "Unary " << node->op;
+    if (node->spec != UnarySpec::GENERIC)
+        out << "  [" << UNARY_SPEC_NAMES[static_cast<int>(node->spec)] << ']';
+    out << '\n';
+    child(node->expr);
+}
+
+void AstPrinter::visit(BinaryOpNode *node)
+{
+    line() << "Binary " << op_text(node->op);
+    if (node->spec != BinarySpec::GENERIC)
+        out << "  [" << BINARY_SPEC_NAMES[static_cast<int>(node->spec)] << ']';
+    out << '\n';
+    child(node->left);
+    child(node->right);
+}
+
+void AstPrinter::visit(VarAccessNode *node)
+{
+    line() << "Var " << node->name;
+    if (node->slot >= 0)
+        out << "  @" << node->slot;
+    out << '\n';
+}
+
+void AstPrinter::visit(IntLiteral *node) { line() << "Int " << node->value << '\n'; }
+void AstPrinter::visit(FloatLiteralNode *node) { line() << "Float " << node->value << '\n'; }
+void AstPrinter::visit(CharLiteralNode *node) { line() << "Char '" << node->value << "'\n"; }
+void AstPrinter::visit(BoolLiteralNode *node) { line() << "Bool " << (node->value ? "true" : "false") << '\n'; }
+void AstPrinter::visit(NullLiteralNode *node) { line() << "Null\n"; }
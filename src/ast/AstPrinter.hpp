@@ -0,0 +1,55 @@
+#ifndef AST_PRINTER_HPP
+#define AST_PRINTER_HPP
+
+#include "Visitor.hpp"
+#include <ostream>
+#include <string>
+
+class Node;
+class TypeNode;
+
+// Imprime a AST indentada, um nó por linha (usado por --dump-ast).
+// Mostra também as anotações dos passos anteriores: slots do Resolver e
+// a especialização escolhida pelo TypeChecker.
+class AstPrinter : public Visitor
+{
+public:
+    explicit AstPrinter(std::ostream &out) : out(out) {}
+    void print(ProgramNode *ast);
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    std::ostream &out;
+    int depth = 0;
+
+    std::ostream &line(); // início de linha já indentado
+    void child(Node *node);
+    static std::string type_name(TypeNode *type);
+};
+
+#endif
@@ -2,11 +2,20 @@
 #define BINARY_OP_NODE_HPP
 #include "Expression.hpp"
 #include "Visitor.hpp"
+// Operação escolhida pelo TypeChecker quando os dois operandos têm tipo
+// primitivo conhecido; GENERIC decide pelos valores em tempo de execução.
+enum class BinarySpec : unsigned char {
+    GENERIC,
+    INT_ADD, INT_SUB, INT_MUL, INT_DIV, INT_MOD, INT_LT, INT_GT, INT_EQ, INT_NE,
+    FLOAT_ADD, FLOAT_SUB, FLOAT_MUL, FLOAT_DIV, FLOAT_LT, FLOAT_GT, FLOAT_EQ, FLOAT_NE,
+    CHAR_EQ, CHAR_NE, BOOL_EQ, BOOL_NE, BOOL_AND
+};
 class BinaryOpNode : public Expression {
 public:
     Expression* left;
     char op;
     Expression* right;
+    BinarySpec spec = BinarySpec::GENERIC;
     BinaryOpNode(Expression* l, char o, Expression* r) : left(l), op(o), right(r) {}
     ~BinaryOpNode() { delete left; delete right; }
     void accept(Visitor* v) override { v->visit(this); }
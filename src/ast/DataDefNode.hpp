@@ -3,15 +3,13 @@
 #include "Node.hpp"
 #include "VarDeclNode.hpp"
 #include "Visitor.hpp"
-#include <string>
+#include "Symbol.hpp"
 #include <vector>
-#include <cstdlib>
 class DataDefNode : public Node {
 public:
-    std::string name;
+    Symbol name;
     std::vector<VarDeclNode*> fields;
-    DataDefNode(char* s, std::vector<VarDeclNode*>* f) : name(s) {
-        if (s) free(s);
+    DataDefNode(Symbol s, std::vector<VarDeclNode*>* f) : name(s) {
         if (f) { fields = *f; delete f; }
     }
     ~DataDefNode() { for (auto field : fields) { delete field; } }
@@ -2,15 +2,13 @@
 #define FIELD_ACCESS_NODE_HPP
 #include "Expression.hpp"
 #include "Visitor.hpp"
-#include <string>
-#include <cstdlib>
+#include "Symbol.hpp"
 class FieldAccessNode : public Expression {
 public:
     Expression* record_expr;
-    std::string field_name;
-    FieldAccessNode(Expression* rec, char* field) : record_expr(rec), field_name(field) {
-        if (field) free(field);
-    }
+    Symbol field_name;
+    int field_slot = -1; // posição do campo no registro, preenchida pelo TypeChecker
+    FieldAccessNode(Expression* rec, Symbol field) : record_expr(rec), field_name(field) {}
     ~FieldAccessNode() { delete record_expr; }
     void accept(Visitor* v) override { v->visit(this); }
 };
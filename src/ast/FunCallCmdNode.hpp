@@ -3,16 +3,16 @@
 #include "Command.hpp"
 #include "Expression.hpp"
 #include "Visitor.hpp"
-#include <string>
+#include "Symbol.hpp"
 #include <vector>
-#include <cstdlib>
+class FunDefNode;
 class FunCallCmdNode : public Command {
 public:
-    std::string name;
+    Symbol name;
+    FunDefNode* target = nullptr; // função chamada, resolvida pelo TypeChecker
     std::vector<Expression*> args;
     std::vector<Expression*> lvalues;
-    FunCallCmdNode(char* s, std::vector<Expression*>* a, std::vector<Expression*>* lvals) : name(s) {
-        if (s) free(s);
+    FunCallCmdNode(Symbol s, std::vector<Expression*>* a, std::vector<Expression*>* lvals) : name(s) {
         if (a) { args = *a; delete a; }
         if (lvals) { lvalues = *lvals; delete lvals; }
     }
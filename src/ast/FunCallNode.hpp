@@ -2,15 +2,16 @@
 #define FUN_CALL_NODE_HPP
 #include "Expression.hpp"
 #include "Visitor.hpp"
-#include <string>
+#include "Symbol.hpp"
 #include <vector>
-#include <cstdlib>
+class FunDefNode;
 class FunCallNode : public Expression {
 public:
-    std::string name;
+    Symbol name;
+    FunDefNode* target = nullptr; // função chamada, resolvida pelo TypeChecker
     std::vector<Expression*> args;
     Expression* return_index;
-    FunCallNode(const std::string& s, std::vector<Expression*>* a, Expression* idx) : name(s), return_index(idx) {
+    FunCallNode(Symbol s, std::vector<Expression*>* a, Expression* idx) : name(s), return_index(idx) {
         if (a) { args = *a; delete a; }
     }
     ~FunCallNode() {
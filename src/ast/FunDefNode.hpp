@@ -4,21 +4,22 @@
 #include "BlockCmdNode.hpp"
 #include "TypeNode.hpp"
 #include "Visitor.hpp"
-#include <string>
+#include "Symbol.hpp"
 #include <vector>
-#include <cstdlib>
 class FunDefNode : public Node {
 public:
     struct Param {
-        std::string name;
+        Symbol name;
         TypeNode* type;
     };
-    std::string name;
+    Symbol name;
     std::vector<Param> params;
     std::vector<TypeNode*> return_types;
     BlockCmdNode* body;
-    FunDefNode(char* s, std::vector<Param>* p, std::vector<TypeNode*>* r, BlockCmdNode* b) : name(s), body(b) {
-        if (s) free(s);
+    int frame_size = 0; // parâmetros + locais, calculado pelo Resolver
+    bool pure = false;       // sem efeitos observáveis (PurityAnalysis)
+    bool memoizable = false; // pura, com parâmetros e retornos primitivos
+    FunDefNode(Symbol s, std::vector<Param>* p, std::vector<TypeNode*>* r, BlockCmdNode* b) : name(s), body(b) {
         if (p) { params = *p; delete p; }
         if (r) { return_types = *r; delete r; }
     }
@@ -3,16 +3,15 @@
 #include "Command.hpp"
 #include "Expression.hpp"
 #include "Visitor.hpp"
-#include <string>
-#include <cstdlib>
+#include "Symbol.hpp"
 class IterateCmdNode : public Command {
 public:
-    std::string loop_variable;
+    Symbol loop_variable; // vazio em iterate(n)
     Expression* condition;
     Command* body;
-    IterateCmdNode(const char* var, Expression* cond, Command* b) : loop_variable(var ? var : ""), condition(cond), body(b) {
-      if (var && var[0] != '\0') free((void*)var);
-    }
+    int loop_slot = -1; // slot de loop_variable, preenchido pelo Resolver
+    bool over_array = false; // iterate(x : v) com v array: x recebe os elementos (TypeChecker)
+    IterateCmdNode(Symbol var, Expression* cond, Command* b) : loop_variable(var), condition(cond), body(b) {}
     ~IterateCmdNode() {
         delete condition;
         delete body;
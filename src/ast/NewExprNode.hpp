@@ -12,6 +12,7 @@ class NewExprNode : public Expression
 public:
     TypeNode *base_type;            // O tipo base, ex: Transition
     std::vector<Expression *> dims; // Lista de expressões de dimensão
+    bool frame_local = false;       // não escapa da chamada (EscapeAnalysis)
 
     NewExprNode(TypeNode *base, std::vector<Expression *> *d) : base_type(base)
     {
@@ -1,8 +1,10 @@
 #ifndef NODE_HPP
 #define NODE_HPP
+#include "SourceLoc.hpp"
 class Visitor;
 class Node {
 public:
+    SourceLoc loc; // onde o nó começa no código-fonte (linha 0 se desconhecida)
     virtual ~Node() = default;
     virtual void accept(Visitor* v) = 0;
 };
@@ -3,9 +3,17 @@
 #include "Command.hpp"
 #include "Expression.hpp"
 #include "Visitor.hpp"
+#include "../typecheck/Primitive.hpp"
 class ReadCmdNode : public Command {
 public:
     Expression* lvalue;
+    bool declares = false; // o read cria a variável (Resolver)
+    // Tipo inferido pelo TypeChecker para a variável criada pelo read;
+    // VOID quando não há uso que o determine (decidido pelo texto lido).
+    Primitive declared_type = Primitive::VOID;
+    // Tipo do campo ou elemento lido (`read p.x`, `read a[i]`), do TypeChecker;
+    // VOID quando não é primitivo e o read não lê nada.
+    Primitive target_type = Primitive::VOID;
     explicit ReadCmdNode(Expression* l) : lvalue(l) {}
     ~ReadCmdNode() { delete lvalue; }
     void accept(Visitor* v) override { v->visit(this); }
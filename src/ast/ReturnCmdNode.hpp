@@ -7,6 +7,7 @@
 class ReturnCmdNode : public Command {
 public:
     std::vector<Expression*> expressions;
+    bool tail_call = false; // `return g(...)[0]` com g de um só retorno; marcado pelo TypeChecker
     explicit ReturnCmdNode(std::vector<Expression*>* exprs) { if(exprs) { expressions = *exprs; delete exprs; } }
     ~ReturnCmdNode() {
         for(auto expr : expressions) {
@@ -0,0 +1,49 @@
+#include "SourceLoc.hpp"
+#include <deque>
+
+static std::deque<std::string> &source_files()
+{
+    static std::deque<std::string> files{""};
+    return files;
+}
+
+uint16_t register_source_file(const std::string &path)
+{
+    std::deque<std::string> &files = source_files();
+    files.push_back(path);
+    return static_cast<uint16_t>(files.size() - 1);
+}
+
+const std::string &source_file_name(uint16_t file)
+{
+    const std::deque<std::string> &files = source_files();
+    return file < files.size() ? files[file] : files[0];
+}
+
+std::string to_string(const SourceLoc &loc)
+{
+    if (loc.line == 0)
+        return "";
+    const std::string &file = source_file_name(loc.file);
+    if (file.empty())
+        return "linha " + std::to_string(loc.line);
+    return file + ':' + std::to_string(loc.line) + ':' + std::to_string(loc.column);
+}
+
+void rethrow_at(const SourceLoc &loc)
+{
+    try
+    {
+        throw;
+    }
+    catch (const SourceError &)
+    {
+        throw;
+    }
+    catch (const std::runtime_error &e)
+    {
+        if (loc.line == 0)
+            throw;
+        throw SourceError(loc, e.what());
+    }
+}
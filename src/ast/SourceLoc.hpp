@@ -0,0 +1,39 @@
+#ifndef SOURCE_LOC_HPP
+#define SOURCE_LOC_HPP
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Posição de um nó no código-fonte (início do primeiro token), preenchida
+// pelo parser com %locations. Ocupa 8 bytes, o mesmo espaço que o
+// alinhamento já reservava depois do vptr de Node.
+struct SourceLoc
+{
+    uint32_t line = 0; // 0: desconhecida (nós criados depois do parser)
+    uint16_t column = 0;
+    uint16_t file = 0; // ver register_source_file()
+};
+
+// Registra o caminho de um arquivo-fonte e devolve o seu número (a partir de 1).
+uint16_t register_source_file(const std::string &path);
+const std::string &source_file_name(uint16_t file);
+
+// "arquivo:linha:coluna", ou "linha N" sem arquivo; vazio se desconhecida.
+std::string to_string(const SourceLoc &loc);
+
+// Erro (semântico ou de execução) já associado a uma posição do código; a
+// mensagem começa com ela. Os visitantes acrescentam a posição do comando
+// que falhou às exceções que ainda não têm uma.
+class SourceError : public std::runtime_error
+{
+public:
+    SourceError(const SourceLoc &loc, const std::string &message)
+        : std::runtime_error(to_string(loc) + ": " + message), loc(loc) {}
+    const SourceLoc loc;
+};
+
+// Para usar dentro de um catch: relança a exceção atual como SourceError em
+// 'loc', a menos que ela já tenha uma posição ou 'loc' seja desconhecida.
+[[noreturn]] void rethrow_at(const SourceLoc &loc);
+
+#endif
@@ -0,0 +1,54 @@
+#include "Symbol.hpp"
+#include <deque>
+#include <ostream>
+#include <unordered_map>
+
+namespace
+{
+// std::deque não move os elementos ao crescer, então as string_view do
+// índice continuam apontando para os textos guardados.
+struct SymbolTable
+{
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+
+    SymbolTable()
+    {
+        names.emplace_back();
+        ids.emplace(names.back(), 0);
+    }
+};
+
+SymbolTable &table()
+{
+    static SymbolTable symbols;
+    return symbols;
+}
+} // namespace
+
+Symbol Symbol::intern(std::string_view text)
+{
+    SymbolTable &symbols = table();
+    auto it = symbols.ids.find(text);
+    if (it != symbols.ids.end())
+        return Symbol{it->second};
+    auto id = static_cast<std::uint32_t>(symbols.names.size());
+    symbols.names.emplace_back(text);
+    symbols.ids.emplace(symbols.names.back(), id);
+    return Symbol{id};
+}
+
+const std::string &Symbol::str() const
+{
+    return table().names[id];
+}
+
+std::size_t symbol_count()
+{
+    return table().names.size();
+}
+
+std::ostream &operator<<(std::ostream &out, Symbol sym)
+{
+    return out << sym.str();
+}
@@ -0,0 +1,63 @@
+#ifndef SYMBOL_HPP
+#define SYMBOL_HPP
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Nome internado (variável, função, campo ou tipo). O texto fica guardado
+// uma única vez numa tabela global, preenchida pelo lexer; a AST guarda só
+// o índice. Dois símbolos são o mesmo nome se e somente se têm o mesmo id.
+//
+// É um tipo trivial (cabe na %union do Bison); Symbol{} é o nome vazio.
+struct Symbol
+{
+    std::uint32_t id;
+
+    static Symbol intern(std::string_view text);
+
+    const std::string &str() const;
+    operator const std::string &() const { return str(); }
+    bool empty() const { return id == 0; }
+
+    bool operator==(Symbol other) const { return id == other.id; }
+    bool operator!=(Symbol other) const { return id != other.id; }
+};
+
+// Para mensagens de erro e impressão, um símbolo se comporta como o seu texto.
+std::ostream &operator<<(std::ostream &out, Symbol sym);
+inline std::string operator+(const std::string &lhs, Symbol rhs) { return lhs + rhs.str(); }
+inline std::string operator+(const char *lhs, Symbol rhs) { return lhs + rhs.str(); }
+inline std::string operator+(Symbol lhs, const std::string &rhs) { return lhs.str() + rhs; }
+inline std::string operator+(Symbol lhs, const char *rhs) { return lhs.str() + rhs; }
+
+// Mapa de Symbol para T guardado num vetor indexado pelo id (os ids são
+// densos). Uma entrada igual a T() (nullptr, ponteiro vazio) conta como
+// ausente; a consulta é um acesso a vetor, sem comparar texto.
+template <typename T>
+class SymbolMap
+{
+public:
+    const T &get(Symbol key) const
+    {
+        static const T absent{};
+        return key.id < slots.size() ? slots[key.id] : absent;
+    }
+    bool contains(Symbol key) const { return key.id < slots.size() && slots[key.id] != T(); }
+    T &operator[](Symbol key)
+    {
+        if (key.id >= slots.size())
+            slots.resize(key.id + 1);
+        return slots[key.id];
+    }
+    void clear() { slots.clear(); }
+
+private:
+    std::vector<T> slots;
+};
+
+// Quantidade de símbolos já internados (inclui o nome vazio, id 0).
+std::size_t symbol_count();
+
+#endif
@@ -4,24 +4,20 @@
 #include "Node.hpp"
 #include "Visitor.hpp"
 #include "../typecheck/Primitive.hpp" // INCLUÍDO
-#include <string>
+#include "Symbol.hpp"
 
 class TypeNode : public Node
 {
 public:
-    Primitive p_type;
-    std::string user_type_name;
-    bool is_primitive;
+    Primitive p_type = Primitive::VOID;
+    Symbol user_type_name{};
+    bool is_primitive = false;
     // --- Novos campos para suportar arrays ---
     bool is_array = false;
     TypeNode *element_type = nullptr; // Se is_array=true, aponta para o tipo do elemento
 
     explicit TypeNode(Primitive t) : p_type(t), is_primitive(true) {}
-    explicit TypeNode(char *s) : user_type_name(s), is_primitive(false)
-    {
-        if (s)
-            free(s);
-    }
+    explicit TypeNode(Symbol s) : p_type(Primitive::VOID), user_type_name(s), is_primitive(false) {}
 
     // --- Novo construtor para tipos de array ---
     explicit TypeNode(TypeNode *elem_t) : is_array(true), element_type(elem_t) {}
@@ -2,10 +2,13 @@
 #define UNARY_OP_NODE_HPP
 #include "Expression.hpp"
 #include "Visitor.hpp"
+// Como em BinarySpec: preenchido pelo TypeChecker quando o tipo do operando é conhecido.
+enum class UnarySpec : unsigned char { GENERIC, INT_NEG, FLOAT_NEG, BOOL_NOT };
 class UnaryOpNode : public Expression {
 public:
     char op;
     Expression* expr;
+    UnarySpec spec = UnarySpec::GENERIC;
     UnaryOpNode(char o, Expression* e) : op(o), expr(e) {}
     ~UnaryOpNode() { delete expr; }
     void accept(Visitor* v) override { v->visit(this); }
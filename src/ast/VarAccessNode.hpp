@@ -2,12 +2,12 @@
 #define VAR_ACCESS_NODE_HPP
 #include "Expression.hpp"
 #include "Visitor.hpp"
-#include <string>
-#include <cstdlib>
+#include "Symbol.hpp"
 class VarAccessNode : public Expression {
 public:
-    std::string name;
-    explicit VarAccessNode(char* s) : name(s) { if(s) free(s); }
+    Symbol name;
+    int slot = -1; // slot no frame da função, preenchido pelo Resolver (-1: não resolvida)
+    explicit VarAccessNode(Symbol s) : name(s) {}
     void accept(Visitor* v) override { v->visit(this); }
 };
 #endif
\ No newline at end of file
@@ -3,13 +3,14 @@
 #include "Command.hpp"
 #include "TypeNode.hpp"
 #include "Visitor.hpp"
-#include <string>
-#include <cstdlib>
+#include "Symbol.hpp"
 class VarDeclNode : public Command {
 public:
-    std::string name;
+    Symbol name;
     TypeNode* type;
-    VarDeclNode(char* s, TypeNode* t) : name(s), type(t) { if(s) free(s); }
+    int slot = -1; // preenchido pelo Resolver
+    bool frame_local = false; // o registro criado não escapa da chamada (EscapeAnalysis)
+    VarDeclNode(Symbol s, TypeNode* t) : name(s), type(t) {}
     ~VarDeclNode() { delete type; }
     void accept(Visitor* v) override { v->visit(this); }
 };
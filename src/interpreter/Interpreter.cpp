@@ -1,82 +1,86 @@
 #include "Interpreter.hpp"
-#include "ReturnSignal.hpp"
+#include "Profiler.hpp"
 #include "../ast/AST.hpp"
+#include "../runtime/Input.hpp"
 #include "../runtime/Values.hpp"
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <cstring>
 #include <cstdio>
+#include <cstdint>
 
-Value *Interpreter::create_default_value(TypeNode *type)
+namespace
 {
-    std::set<std::string> visited;
+    // Pilha nativa reservada por chamada ativa da linguagem (uma chamada
+    // típica usa bem menos) e a folga mantida para o restante do programa.
+    constexpr std::size_t NATIVE_BYTES_PER_CALL = 2048;
+    constexpr std::size_t NATIVE_RESERVE = 1024 * 1024;
+
+    // Mantém um valor intermediário visível ao coletor enquanto estiver no escopo.
+    struct TempRoot
+    {
+        std::vector<Value> &roots;
+        TempRoot(std::vector<Value> &r, const Value &v) : roots(r) { roots.push_back(v); }
+        ~TempRoot() { roots.pop_back(); }
+    };
+}
+
+Value Interpreter::create_default_value(TypeNode *type)
+{
+    std::vector<Symbol> visited;
     return create_default_value(type, visited);
 }
 
-Value *Interpreter::create_default_value(TypeNode *type, std::set<std::string> &visited_records)
+Value Interpreter::create_default_value(TypeNode *type, std::vector<Symbol> &visited_records)
 {
     if (!type || type->is_array)
     {
-        return nullptr;
+        return Value();
     }
 
     if (type->is_primitive)
     {
-        Value *val = nullptr;
         switch (type->p_type)
         {
         case Primitive::INT:
-            val = new IntValue(0);
-            break;
+            return Value::make_int(0);
         case Primitive::FLOAT:
-            val = new FloatValue(0.0f);
-            break;
+            return Value::make_float(0.0f);
         case Primitive::CHAR:
-            val = new CharValue('\0');
-            break;
+            return Value::make_char('\0');
         case Primitive::BOOL:
-            val = new BoolValue(false);
-            break;
+            return Value::make_bool(false);
         default:
-            return nullptr;
+            return Value();
         }
-        if (val)
-            value_pool.push_back(val);
-        return val;
     }
     else
     { // É um tipo de registro
-        std::string type_name = type->user_type_name;
-
-        // ==================================================================
-        // ====> COLOQUE A MENSAGEM DE DEBUG EXATAMENTE AQUI <====
-        // ==================================================================
-        std::cerr << "[DEBUG] Tentando criar valor padrão para o tipo de registro: '" << type_name << "'.\n";
+        Symbol type_name = type->user_type_name;
 
-        // VERIFICAÇÃO DE RECURSÃO
-        if (visited_records.count(type_name))
+        // Um tipo que já está sendo criado (campo recursivo) começa null.
+        if (std::find(visited_records.begin(), visited_records.end(), type_name) != visited_records.end())
         {
-            std::cerr << "    └─ DETECTADO CICLO! O tipo '" << type_name << "' já está sendo criado. Retornando 'null' para quebrar a recursão.\n";
-            return nullptr;
+            return Value();
         }
-        // ==================================================================
 
-        if (data_types.count(type_name))
+        if (DataDefNode *def = data_types.get(type_name))
         {
-            visited_records.insert(type_name);
-            DataDefNode *def = data_types.at(type_name);
-            auto *record = new RecordValue(type_name);
-            value_pool.push_back(record);
+            visited_records.push_back(type_name);
+            std::vector<Value> fields;
+            fields.reserve(def->fields.size());
 
             for (VarDeclNode *field : def->fields)
             {
-                record->fields[field->name] = create_default_value(field->type, visited_records);
+                fields.push_back(create_default_value(field->type, visited_records));
             }
 
-            visited_records.erase(type_name);
-            return record;
+            visited_records.pop_back();
+            return Value::make_ref(heap.make<RecordValue>(record_shapes.get(type_name).get(), std::move(fields)));
         }
     }
-    return nullptr;
+    return Value();
 }
 
 /**
@@ -86,9 +90,9 @@ Value *Interpreter::create_default_value(TypeNode *type, std::set<std::string> &
  * @param dim_index O índice da dimensão atual que está sendo alocada.
  */
 
-Value *Interpreter::create_nested_array(TypeNode *base_elem_type,
-                                        const std::vector<Expression *> &dims,
-                                        size_t dim_index)
+Value Interpreter::create_nested_array(TypeNode *base_elem_type,
+                                       const std::vector<Expression *> &dims,
+                                       size_t dim_index)
 {
     if (dim_index >= dims.size())
     {
@@ -96,115 +100,174 @@ Value *Interpreter::create_nested_array(TypeNode *base_elem_type,
     }
 
     dims[dim_index]->accept(this);
-    auto *size_val = dynamic_cast<IntValue *>(last_value);
-    if (!size_val || size_val->value < 0)
+    if (!last_value.is_int() || last_value.i < 0)
     {
         throw std::runtime_error("Erro de Execução: Dimensão de array inválida.");
     }
-    size_t size = size_val->value;
+    size_t size = last_value.i;
+
+    // A última dimensão de um tipo primitivo é compactada e já nasce zerada.
+    if (dim_index + 1 == dims.size() && base_elem_type->is_primitive)
+    {
+        return Value::make_ref(heap.make<ArrayValue>(size, packed_kind(base_elem_type->p_type)));
+    }
 
-    auto *arr_val = new ArrayValue();
-    value_pool.push_back(arr_val);
-    arr_val->elements.resize(size);
+    auto *arr_val = heap.make<ArrayValue>(size);
+    TempRoot root(temp_roots, Value::make_ref(arr_val));
 
     for (size_t i = 0; i < size; ++i)
     {
         arr_val->elements[i] = create_nested_array(base_elem_type, dims, dim_index + 1);
     }
 
-    return arr_val;
+    return Value::make_ref(arr_val);
 }
-// ... (todo o topo do arquivo: destrutor, push/pop_scope, etc. continua igual) ...
-Interpreter::~Interpreter()
+Interpreter::Interpreter(const InterpreterOptions &options)
+    : heap(options.gc_threshold), max_stack(options.max_stack), memo_capacity(options.memoize),
+      mem_stats_every(options.mem_stats_every)
 {
-    for (Value *v : value_pool)
-    {
-        delete v;
-    }
 }
-void Interpreter::push_scope() { memory_stack.emplace_back(); }
-void Interpreter::pop_scope()
+
+// Os objetos restantes são liberados pelo destrutor do Heap.
+Interpreter::~Interpreter() = default;
+
+void Interpreter::collect_garbage()
+{
+    heap.collect([this](Heap &h)
+                 {
+        for (const Value &v : frame_slots)
+            h.mark(v);
+        for (const Value &v : temp_roots)
+            h.mark(v);
+        for (const Value &v : return_values)
+            h.mark(v);
+        h.mark(last_value); });
+    if (mem_stats_every && heap.stats().collections % mem_stats_every == 0)
+        print_mem_snapshot(std::cerr, heap, stack_stats);
+}
+
+bool Interpreter::call_function(FunDefNode *func_def, const std::vector<Expression *> &args)
 {
-    if (!memory_stack.empty())
+    if (args.size() != func_def->params.size())
     {
-        memory_stack.pop_back();
+        for (Expression *arg_expr : args)
+            arg_expr->accept(this);
+        return false;
     }
-}
-void Interpreter::set_variable(const std::string &name, Value *value, bool is_decl)
-{
-    if (is_decl && !memory_stack.empty())
+
+    // O frame da chamada é reservado antes de avaliar os argumentos, que
+    // são gravados direto nos slots dos parâmetros (e já são raízes do
+    // coletor ali). Chamadas feitas pelos argumentos empilham os seus
+    // frames depois deste; os argumentos ainda são avaliados no frame atual.
+    std::size_t callee_base = frame_slots.size();
+    frame_slots.resize(callee_base + func_def->frame_size); // locais começam nulos
+    for (std::size_t i = 0; i < args.size(); ++i)
     {
-        memory_stack.back()[name] = value;
+        args[i]->accept(this);
+        frame_slots[callee_base + i] = last_value;
     }
-}
 
-void Interpreter::update_variable(const std::string &name, Value *new_value)
-{
-    for (auto it = memory_stack.rbegin(); it != memory_stack.rend(); ++it)
+    // Função pura já chamada com os mesmos argumentos: nem entra no corpo.
+    MemoCache *cache = nullptr;
+    std::string memo_key;
+    if (memo_capacity > 0 && func_def->memoizable)
     {
-        if (it->count(name))
+        cache = &memo.try_emplace(func_def, memo_capacity).first->second;
+        memo_key = MemoCache::key_of(frame_slots.data() + callee_base, args.size());
+        if (const std::vector<Value> *results = cache->find(memo_key))
         {
-            Value *old_value = it->at(name);
-
-            // Se for um tipo primitivo, copiamos o valor interno.
-            if (auto i_old = dynamic_cast<IntValue *>(old_value))
-            {
-                if (auto i_new = dynamic_cast<IntValue *>(new_value))
-                {
-                    i_old->value = i_new->value;
-                    return;
-                }
-            }
-            if (auto f_old = dynamic_cast<FloatValue *>(old_value))
-            {
-                if (auto f_new = dynamic_cast<FloatValue *>(new_value))
-                {
-                    f_old->value = f_new->value;
-                    return;
-                }
-            }
-            if (auto c_old = dynamic_cast<CharValue *>(old_value))
-            {
-                if (auto c_new = dynamic_cast<CharValue *>(new_value))
-                {
-                    c_old->value = c_new->value;
-                    return;
-                }
-            }
-            if (auto b_old = dynamic_cast<BoolValue *>(old_value))
-            {
-                if (auto b_new = dynamic_cast<BoolValue *>(new_value))
-                {
-                    b_old->value = b_new->value;
-                    return;
-                }
-            }
-
-            // Para todos os outros casos (registros, arrays, null), trocamos o ponteiro.
-            (*it)[name] = new_value;
-            return;
+            return_values = *results;
+            frame_slots.resize(callee_base);
+            return true;
         }
     }
+
+    char probe;
+    if (call_depth >= max_stack || &probe < native_floor)
+        throw std::runtime_error(call_depth >= max_stack ? stack_overflow_message(max_stack)
+                                                         : native_stack_exhausted_message(call_depth));
+    ++call_depth;
+    stack_stats.enter(call_depth, frame_slots.size());
+
+    std::size_t saved_base = frame_base;
+    frame_base = callee_base;
+    heap.push_region();
+    if (profiler)
+        profiler->enter(func_def);
+
+    bool tail = false;
+    for (;;)
+    {
+        func_def->body->accept(this);
+        if (!tail_target)
+            break;
+        // `return g(...)[0]`: a região e os locais deste frame morrem aqui
+        // (os argumentos de g nunca estão na região, ver EscapeAnalysis) e
+        // g roda no lugar da função atual.
+        func_def = tail_target;
+        tail_target = nullptr;
+        returning = false;
+        tail = true;
+        last_value = Value();
+        heap.pop_region();
+        frame_slots.resize(frame_base);
+        frame_slots.resize(frame_base + func_def->frame_size);
+        std::copy(return_values.begin(), return_values.end(), frame_slots.begin() + frame_base);
+        stack_stats.enter(call_depth, frame_slots.size());
+        heap.push_region();
+        if (profiler)
+            profiler->replace(func_def);
+    }
+    if (returning)
+        returning = false;
+    else if (tail)
+        return_values.assign(1, Value()); // o [0] de um g que terminou sem 'return'
+    else
+        return_values.clear(); // terminou sem 'return'
+    if (cache)
+        cache->insert(memo_key, return_values); // as chamadas de cauda dão o mesmo resultado
+    if (profiler)
+        profiler->leave();
+
+    // Os objetos da região só eram alcançáveis pelos locais deste frame
+    // (e, de passagem, por last_value).
+    last_value = Value();
+    heap.pop_region();
+    frame_slots.resize(frame_base);
+    frame_base = saved_base;
+    --call_depth;
+    return true;
 }
 
-Value *Interpreter::get_variable(const std::string &name)
+// Blocos não contam: a linha deles é a do comando que os contém.
+void Interpreter::profile_line(Command *cmd)
 {
-    for (auto it = memory_stack.rbegin(); it != memory_stack.rend(); ++it)
-    {
-        if (it->count(name))
-        {
-            return it->at(name);
-        }
-    }
-    return nullptr;
+    if (!dynamic_cast<BlockCmdNode *>(cmd))
+        profiler->hit(static_cast<int>(cmd->loc.line));
+}
+
+void Interpreter::print_memo_stats(std::ostream &os) const
+{
+    std::map<std::string, const MemoCache *> by_name;
+    for (const auto &entry : memo)
+        by_name[entry.first->name] = &entry.second;
+    for (const auto &entry : by_name)
+        entry.second->print_stats(os, entry.first);
 }
 
 void Interpreter::interpret(ProgramNode *ast)
 {
-    push_scope();
-    if (ast)
-        ast->accept(this);
-    pop_scope();
+    if (!ast)
+        return;
+    // Sem estouro na conta mesmo com um max_stack enorme; se não houver
+    // memória para tanto, run_on_native_stack reserva menos.
+    std::size_t calls = std::min(max_stack, (SIZE_MAX - NATIVE_RESERVE) / NATIVE_BYTES_PER_CALL);
+    std::size_t bytes = calls * NATIVE_BYTES_PER_CALL + NATIVE_RESERVE;
+    run_on_native_stack(bytes, [&](std::size_t usable)
+                        {
+        char top;
+        native_floor = usable ? &top - usable + std::min(NATIVE_RESERVE / 2, usable / 2) : nullptr;
+        ast->accept(this); });
 }
 
 // ============ Implementação dos Métodos visit() ============
@@ -227,12 +290,10 @@ void Interpreter::visit(ProgramNode *node)
         def->accept(this);
 
     /* 2. procura por “main” ------------------------------------------------ */
-    auto it = functions.find("main");
-    if (it == functions.end())
+    FunDefNode *mdef = functions.get(Symbol::intern("main"));
+    if (!mdef)
         return; // não há main()
 
-    FunDefNode *mdef = it->second;
-
     /* 3. constrói vetor de argumentos se main espera algo ------------------ */
     auto *arg_vec = new std::vector<Expression *>;
     if (mdef->params.size() == 1) // um único parâmetro
@@ -268,14 +329,22 @@ void Interpreter::visit(ProgramNode *node)
     }
 
     /* 4. dispara a execução de main ---------------------------------------- */
-    visit(new FunCallCmdNode(strdup("main"), arg_vec,
-                             new std::vector<Expression *>));
+    auto *call = new FunCallCmdNode(Symbol::intern("main"), arg_vec, new std::vector<Expression *>);
+    call->target = mdef;
+    visit(call);
 }
 
 // MODIFICADO: Registra a definição do tipo 'data'
 void Interpreter::visit(DataDefNode *node)
 {
     data_types[node->name] = node;
+
+    // Os campos ocupam slots na ordem da definição, como no TypeChecker.
+    auto shape = std::make_shared<RecordShape>();
+    shape->name = node->name;
+    for (VarDeclNode *field : node->fields)
+        shape->field_names.push_back(field->name);
+    record_shapes[node->name] = shape;
 }
 
 /**
@@ -292,6 +361,10 @@ void Interpreter::visit(NewExprNode *node)
             throw std::runtime_error("Erro de Execução: 'new' em tipo primitivo deve ser uma alocação de array.");
         }
         last_value = create_default_value(node->base_type);
+        if (node->frame_local && last_value.is_ref())
+        {
+            heap.to_region(last_value.ref);
+        }
         return;
     }
 
@@ -319,305 +392,272 @@ void Interpreter::visit(NewExprNode *node)
 
     // Avalia a expressão de tamanho que encontramos.
     size_expr->accept(this);
-    auto *size_val = dynamic_cast<IntValue *>(last_value);
-    if (!size_val || size_val->value < 0)
+    if (!last_value.is_int() || last_value.i < 0)
     {
         throw std::runtime_error("Erro de Execução: Tamanho do array inválido.");
     }
 
-    size_t size = size_val->value;
+    size_t size = last_value.i;
 
-    // Cria o array externo com o tamanho encontrado e o preenche com `nullptr`.
+    // Cria o array externo com o tamanho encontrado e o preenche com `null`.
     // As dimensões internas serão alocadas depois (ex: em setNumTransitions).
-    auto *arr_val = new ArrayValue();
-    value_pool.push_back(arr_val);
-    arr_val->elements.resize(size, nullptr); // Redimensiona e preenche com ponteiros nulos
+    // Com uma só dimensão de tipo primitivo (new Int[n]) o array é compactado
+    // e os elementos começam em zero.
+    ValueKind elem = ValueKind::NIL;
+    if (node->dims.size() == 1 && node->base_type->is_primitive)
+    {
+        elem = packed_kind(node->base_type->p_type);
+    }
+    auto *arr_val = heap.make<ArrayValue>(size, elem);
+    if (node->frame_local)
+    {
+        heap.to_region(arr_val);
+    }
 
-    last_value = arr_val;
+    last_value = Value::make_ref(arr_val);
 }
 void Interpreter::visit(FunDefNode *node) { functions[node->name] = node; }
 void Interpreter::visit(FunCallNode *node)
 {
-    if (!functions.count(node->name))
+    FunDefNode *func_def = node->target ? node->target : functions.get(node->name);
+    if (!func_def)
     {
         return;
     }
-    FunDefNode *func_def = functions[node->name];
-    std::vector<Value *> evaluated_args;
-    for (Expression *arg_expr : node->args)
+    if (!call_function(func_def, node->args))
     {
-        arg_expr->accept(this);
-        evaluated_args.push_back(last_value);
+        last_value = Value();
+        return;
     }
-    if (evaluated_args.size() != func_def->params.size())
+
+    // O índice de retorno pertence ao chamador: é avaliado no frame dele.
+    if (auto *idx_literal = dynamic_cast<IntLiteral *>(node->return_index))
     {
-        last_value = nullptr;
+        int k = idx_literal->value;
+        last_value = (k >= 0 && k < (int)return_values.size()) ? return_values[k] : Value();
         return;
     }
-    push_scope();
-    for (size_t i = 0; i < func_def->params.size(); ++i)
+    if (return_values.empty())
     {
-        set_variable(func_def->params[i].name, evaluated_args[i], true);
+        last_value = Value();
+        return;
     }
-    try
+    // Um índice não literal pode chamar outras funções, que reescrevem o
+    // buffer: os valores são guardados em temp_roots enquanto ele é avaliado.
+    size_t roots_mark = temp_roots.size();
+    temp_roots.insert(temp_roots.end(), return_values.begin(), return_values.end());
+    size_t count = return_values.size();
+    node->return_index->accept(this);
+    if (last_value.is_int() && last_value.i >= 0 && (size_t)last_value.i < count)
     {
-        func_def->body->accept(this);
-        last_value = nullptr;
+        last_value = temp_roots[roots_mark + last_value.i];
     }
-    catch (const ReturnSignal &ret)
+    else
     {
-        if (!ret.values.empty())
-        {
-            node->return_index->accept(this);
-            if (auto idx_val = dynamic_cast<IntValue *>(last_value))
-            {
-                if (idx_val->value >= 0 && idx_val->value < ret.values.size())
-                {
-                    last_value = ret.values[idx_val->value];
-                }
-                else
-                {
-                    last_value = nullptr;
-                }
-            }
-            else
-            {
-                last_value = nullptr;
-            }
-        }
-        else
-        {
-            last_value = nullptr;
-        }
+        last_value = Value();
     }
-    pop_scope();
+    temp_roots.resize(roots_mark);
 }
 void Interpreter::visit(FunCallCmdNode *node)
 {
-    if (!functions.count(node->name))
+    FunDefNode *func_def = node->target ? node->target : functions.get(node->name);
+    if (!func_def)
     {
         return;
     }
-    FunDefNode *func_def = functions[node->name];
-    std::vector<Value *> evaluated_args;
-    for (Expression *arg_expr : node->args)
-    {
-        arg_expr->accept(this);
-        evaluated_args.push_back(last_value);
-    }
-    if (evaluated_args.size() != func_def->params.size())
+    if (!call_function(func_def, node->args))
     {
         return;
     }
-    push_scope();
-    for (size_t i = 0; i < func_def->params.size(); ++i)
-    {
-        set_variable(func_def->params[i].name, evaluated_args[i], true);
-    }
-    try
+    if (node->lvalues.size() > 0 && node->lvalues.size() == return_values.size())
     {
-        func_def->body->accept(this);
-    }
-    catch (const ReturnSignal &ret)
-    {
-        if (node->lvalues.size() > 0 && node->lvalues.size() == ret.values.size())
+        for (size_t i = 0; i < node->lvalues.size(); ++i)
         {
-            for (size_t i = 0; i < node->lvalues.size(); ++i)
+            auto var_access = dynamic_cast<VarAccessNode *>(node->lvalues[i]);
+            if (var_access && var_access->slot >= 0)
             {
-                if (auto var_access = dynamic_cast<VarAccessNode *>(node->lvalues[i]))
-                {
-                    update_variable(var_access->name, ret.values[i]);
-                }
+                local(var_access->slot) = return_values[i];
             }
         }
     }
-    pop_scope();
 }
 void Interpreter::visit(FieldAccessNode *node)
 {
     node->record_expr->accept(this);
-    auto *rec_val = dynamic_cast<RecordValue *>(last_value);
+    auto *rec_val = last_value.is_record() ? last_value.as_record() : nullptr;
 
     if (!rec_val)
     {
-        last_value = nullptr;
+        last_value = Value();
         return;
     }
 
-    if (!rec_val->fields.count(node->field_name))
+    int slot = node->field_slot >= 0 ? node->field_slot : rec_val->shape->slot_of(node->field_name);
+    if (slot < 0 || static_cast<size_t>(slot) >= rec_val->fields.size())
     {
-        last_value = nullptr; // campo inexistente
+        last_value = Value(); // campo inexistente
         return;
     }
 
-    last_value = rec_val->fields[node->field_name];
+    last_value = rec_val->fields[slot];
 }
 void Interpreter::visit(ReturnCmdNode *node)
 {
-    ReturnSignal ret_signal;
-    for (Expression *expr : node->expressions)
+    // Numa chamada de cauda só os argumentos são avaliados aqui; call_function
+    // os recebe em return_values e executa a função chamada no mesmo frame.
+    auto *tail_call = node->tail_call ? static_cast<FunCallNode *>(node->expressions[0]) : nullptr;
+    const std::vector<Expression *> &exprs = tail_call ? tail_call->args : node->expressions;
+
+    // As expressões podem conter chamadas, que também usam return_values:
+    // os valores só vão para o buffer depois de todos avaliados.
+    size_t roots_mark = temp_roots.size();
+    for (Expression *expr : exprs)
     {
         expr->accept(this);
-        ret_signal.values.push_back(last_value);
+        temp_roots.push_back(last_value);
     }
-    throw ret_signal;
+    return_values.assign(temp_roots.begin() + roots_mark, temp_roots.end());
+    temp_roots.resize(roots_mark);
+    if (tail_call)
+        tail_target = tail_call->target;
+    returning = true;
 }
 void Interpreter::visit(BlockCmdNode *node)
 {
-    push_scope();
+    // Os escopos do bloco já foram resolvidos para slots do frame.
     for (Command *cmd : node->commands)
     {
-        cmd->accept(this);
+        maybe_collect();
+        if (profiler)
+            profile_line(cmd);
+        try
+        {
+            cmd->accept(this);
+        }
+        catch (...)
+        {
+            rethrow_at(cmd->loc); // o erro sai com a posição do comando mais interno
+        }
+        if (returning)
+            return;
     }
-    pop_scope();
 }
 
 void Interpreter::visit(VarDeclNode *node)
 {
-    Value *default_value = nullptr;
+    Value default_value;
 
     // Caso A: O tipo da variável é primitivo (Int, Float, etc.)
     if (node->type->is_primitive)
     {
-        switch (node->type->p_type)
-        {
-        case Primitive::INT:
-            default_value = new IntValue(0);
-            break;
-        case Primitive::BOOL:
-            default_value = new BoolValue(false);
-            break;
-        case Primitive::FLOAT:
-            default_value = new FloatValue(0.0f);
-            break;
-        case Primitive::CHAR:
-            default_value = new CharValue('\0');
-            break;
-        }
-        // Adiciona o valor primitivo recém-criado ao pool de memória.
-        if (default_value)
-        {
-            value_pool.push_back(default_value);
-        }
+        default_value = create_default_value(node->type);
     }
     // Caso B: O tipo da variável é um registro definido por 'data'
     else
     {
-        std::string type_name = node->type->user_type_name;
-        if (data_types.count(type_name))
+        Symbol type_name = node->type->user_type_name;
+        if (DataDefNode *def = data_types.get(type_name))
         {
-            DataDefNode *def = data_types[type_name];
-            RecordValue *record = new RecordValue(type_name);
-
-            // Adiciona o registro ao pool APENAS UMA VEZ, no momento da criação.
-            value_pool.push_back(record);
 
             // Inicializa todos os campos do registro com seus valores padrão.
+            // Campos de tipo registro ficam nulos.
+            std::vector<Value> fields;
+            fields.reserve(def->fields.size());
             for (VarDeclNode *field : def->fields)
             {
-                Value *field_val = nullptr;
+                Value field_val;
                 if (field->type->is_primitive)
                 {
-                    switch (field->type->p_type)
-                    {
-                    case Primitive::INT:
-                        field_val = new IntValue(0);
-                        break;
-                    case Primitive::BOOL:
-                        field_val = new BoolValue(false);
-                        break;
-                    case Primitive::FLOAT:
-                        field_val = new FloatValue(0.0f);
-                        break;
-                    case Primitive::CHAR:
-                        field_val = new CharValue('\0');
-                        break;
-                    }
-                    if (field_val)
-                    {
-                        value_pool.push_back(field_val); // Adiciona o valor do campo ao pool.
-                    }
+                    field_val = create_default_value(field->type);
                 }
-                record->fields[field->name] = field_val; // Associa campo ao valor (ou nullptr se for outro registro)
+                fields.push_back(field_val);
+            }
+            default_value = Value::make_ref(heap.make<RecordValue>(record_shapes.get(type_name).get(), std::move(fields)));
+            if (node->frame_local)
+            {
+                heap.to_region(default_value.ref);
             }
-            default_value = record;
         }
     }
 
-    // Associa o nome da variável ao seu valor padrão (seja um primitivo, um registro ou nulo).
-    set_variable(node->name, default_value, true);
+    // Guarda o valor padrão (seja um primitivo, um registro ou nulo) no slot da variável.
+    local(node->slot) = default_value;
+}
+
+Value &Interpreter::field_target(FieldAccessNode *fa)
+{
+    // a. Avalia a expressão antes do ponto (ex: 'last') para obter o RecordValue.
+    fa->record_expr->accept(this);
+    auto *record = last_value.is_record() ? last_value.as_record() : nullptr;
+
+    if (!record)
+    {
+        throw std::runtime_error("Erro de Execução: Tentativa de acesso a campo em algo que não é um registro.");
+    }
+
+    // b. Verifica se o campo existe no registro (o slot vem do TypeChecker).
+    int slot = fa->field_slot >= 0 ? fa->field_slot : record->shape->slot_of(fa->field_name);
+    if (slot < 0 || static_cast<size_t>(slot) >= record->fields.size())
+    {
+        throw std::runtime_error("Erro de Execução: Campo '" + fa->field_name + "' não existe no tipo '" + record->type_name() + "'.");
+    }
+    return record->fields[slot];
+}
+
+ArrayValue *Interpreter::element_target(ArrayAccessNode *aa, int &index)
+{
+    // a. Avalia a expressão do array para obter o ArrayValue.
+    aa->array_expr->accept(this);
+    auto *arr_val = last_value.is_array() ? last_value.as_array() : nullptr;
+    if (!arr_val)
+    {
+        throw std::runtime_error("Erro de Execução: Tentativa de acesso por índice em algo que não é um array.");
+    }
+    TempRoot arr_root(temp_roots, last_value);
+
+    // b. Avalia a expressão do índice para obter o valor inteiro.
+    aa->index_expr->accept(this);
+    if (!last_value.is_int())
+    {
+        throw std::runtime_error("Erro de Execução: Índice de array deve ser um inteiro.");
+    }
+
+    index = last_value.i;
+    if (index < 0 || (size_t)index >= arr_val->size())
+    {
+        throw std::runtime_error("Erro de Execução: Índice de array fora dos limites.");
+    }
+    return arr_val;
 }
 
 void Interpreter::visit(AssignCmdNode *node)
 {
     // 1. Avalia a expressão do lado direito (RHS) para obter o valor.
     node->expr->accept(this);
-    Value *rhs_value = last_value;
+    Value rhs_value = last_value;
+    TempRoot rhs_root(temp_roots, rhs_value);
 
     // 2. Determina o tipo do L-Value e realiza a atribuição.
 
     // --- CASO 1: Atribuição a uma variável simples (ex: x = 10) ---
-    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    if (node->target == AssignCmdNode::Target::VARIABLE)
     {
-        // Se a variável já existe na memória, atualiza seu valor.
-        if (get_variable(va->name))
-        {
-            update_variable(va->name, rhs_value);
-        }
-        else
-        {
-            // Se não existe (inferência de tipo), cria no escopo atual.
-            set_variable(va->name, rhs_value, /*is_decl=*/true);
-        }
+        auto *va = static_cast<VarAccessNode *>(node->lvalue);
+        // O Resolver já criou o slot, inclusive para variáveis inferidas.
+        local(va->slot) = rhs_value;
     }
     // --- CASO 2: Atribuição a um campo de registro (ex: last.next = no) ---
-    else if (auto *fa = dynamic_cast<FieldAccessNode *>(node->lvalue))
+    else if (node->target == AssignCmdNode::Target::FIELD)
     {
-        // a. Avalia a expressão antes do ponto (ex: 'last') para obter o RecordValue.
-        fa->record_expr->accept(this);
-        auto *record = dynamic_cast<RecordValue *>(last_value);
-
-        if (!record)
-        {
-            throw std::runtime_error("Erro de Execução: Tentativa de acesso a campo em algo que não é um registro.");
-        }
-
-        // b. Verifica se o campo existe no registro.
-        if (record->fields.find(fa->field_name) == record->fields.end())
-        {
-            throw std::runtime_error("Erro de Execução: Campo '" + fa->field_name + "' não existe no tipo '" + record->type_name + "'.");
-        }
-
-        // c. Atualiza o ponteiro do campo para o novo valor.
-        record->fields[fa->field_name] = rhs_value;
+        field_target(static_cast<FieldAccessNode *>(node->lvalue)) = rhs_value;
     }
     // --- CASO 3: Atribuição a um elemento de array (ex: arr[0] = 5) ---
-    else if (auto *aa = dynamic_cast<ArrayAccessNode *>(node->lvalue))
+    else if (node->target == AssignCmdNode::Target::ELEMENT)
     {
-        // a. Avalia a expressão do array para obter o ArrayValue.
-        aa->array_expr->accept(this);
-        auto *arr_val = dynamic_cast<ArrayValue *>(last_value);
-        if (!arr_val)
-        {
-            throw std::runtime_error("Erro de Execução: Tentativa de acesso por índice em algo que não é um array.");
-        }
-
-        // b. Avalia a expressão do índice para obter o valor inteiro.
-        aa->index_expr->accept(this);
-        auto *idx_val = dynamic_cast<IntValue *>(last_value);
-        if (!idx_val)
-        {
-            throw std::runtime_error("Erro de Execução: Índice de array deve ser um inteiro.");
-        }
-
-        int index = idx_val->value;
-        if (index < 0 || (size_t)index >= arr_val->elements.size())
-        {
-            throw std::runtime_error("Erro de Execução: Índice de array fora dos limites.");
-        }
-
-        // c. Atualiza o ponteiro do elemento para o novo valor.
-        arr_val->elements[index] = rhs_value;
+        int index;
+        ArrayValue *arr_val = element_target(static_cast<ArrayAccessNode *>(node->lvalue), index);
+        // Atualiza o elemento com o novo valor (direto no buffer compactado, se for o caso).
+        arr_val->set(index, rhs_value);
     }
     // --- ERRO: Tipo de l-value não suportado ---
     else
@@ -628,323 +668,324 @@ void Interpreter::visit(AssignCmdNode *node)
 void Interpreter::visit(PrintCmd *node)
 {
     node->expr->accept(this);
-    if (last_value)
+    if (!last_value.is_nil())
     {
-        last_value->print();
-        std::cout << std::endl;
+        Output &out = Output::standard();
+        last_value.print(out);
+        out.end_line();
     }
 }
 void Interpreter::visit(ReadCmdNode *node)
 {
     if (auto va = dynamic_cast<VarAccessNode *>(node->lvalue))
     {
-        Value *tv = get_variable(va->name);
-        if (!tv)
-            return;
-        if (auto ib = dynamic_cast<IntValue *>(tv))
-        {
-            std::cin >> ib->value;
-        }
-        else if (auto fb = dynamic_cast<FloatValue *>(tv))
-        {
-            std::cin >> fb->value;
-        }
-        else if (auto cb = dynamic_cast<CharValue *>(tv))
+        Value &target = local(va->slot);
+        if (node->declares)
         {
-            std::cin >> cb->value;
+            // Variável criada pelo read: lê conforme o tipo inferido pelo
+            // TypeChecker ou, se ele não foi decidido, conforme a entrada.
+            target = default_for(node->declared_type);
         }
+        read_value(Scanner::standard(), target);
+    }
+    else if (auto fa = dynamic_cast<FieldAccessNode *>(node->lvalue))
+    {
+        read_into(Scanner::standard(), field_target(fa), node->target_type);
+    }
+    else if (auto aa = dynamic_cast<ArrayAccessNode *>(node->lvalue))
+    {
+        int index;
+        ArrayValue *arr_val = element_target(aa, index);
+        Value element = arr_val->get(index);
+        read_into(Scanner::standard(), element, node->target_type);
+        arr_val->set(index, element);
     }
 }
 void Interpreter::visit(IfCmdNode *node)
 {
     node->condition->accept(this);
-    if (auto bv = dynamic_cast<BoolValue *>(last_value))
+    if (last_value.is_bool())
     {
-        if (bv->value)
+        Command *branch = last_value.b ? node->then_branch : node->else_branch;
+        if (branch)
         {
-            node->then_branch->accept(this);
-        }
-        else if (node->else_branch)
-        {
-            node->else_branch->accept(this);
+            if (profiler)
+                profile_line(branch);
+            branch->accept(this);
         }
     }
 }
 void Interpreter::visit(IterateCmdNode *node)
 {
     node->condition->accept(this);
-    auto cv = dynamic_cast<IntValue *>(last_value);
-    if (!cv)
+    bool hlv = node->loop_slot >= 0;
+    if (last_value.is_array())
+    {
+        // O corpo pode reatribuir a variável do array: ele fica enraizado até o fim do laço.
+        ArrayValue *arr = last_value.as_array();
+        TempRoot root(temp_roots, last_value);
+        for (std::size_t k = 0; k < arr->size(); ++k)
+        {
+            maybe_collect();
+            if (hlv)
+            {
+                local(node->loop_slot) = arr->get(k);
+            }
+            if (profiler)
+                profile_line(node->body);
+            node->body->accept(this);
+            if (returning)
+                break;
+        }
         return;
-    int n = cv->value;
-    bool hlv = !node->loop_variable.empty();
-    if (hlv)
-        push_scope();
+    }
+    if (!last_value.is_int())
+        return;
+    int n = last_value.i;
     for (int i = 0; i < n; ++i)
     {
+        maybe_collect();
         if (hlv)
         {
-            Value *lvv = new IntValue(i);
-            value_pool.push_back(lvv);
-            set_variable(node->loop_variable, lvv, true);
+            local(node->loop_slot) = Value::make_int(i);
         }
+        if (profiler)
+            profile_line(node->body);
         node->body->accept(this);
+        if (returning)
+            break;
     }
-    if (hlv)
-        pop_scope();
 }
-void Interpreter::visit(IntLiteral *node)
+void Interpreter::visit(IntLiteral *node) { last_value = Value::make_int(node->value); }
+void Interpreter::visit(FloatLiteralNode *node) { last_value = Value::make_float(node->value); }
+void Interpreter::visit(CharLiteralNode *node) { last_value = Value::make_char(node->value); }
+void Interpreter::visit(BoolLiteralNode *node) { last_value = Value::make_bool(node->value); }
+void Interpreter::visit(VarAccessNode *node)
 {
-    last_value = new IntValue(node->value);
-    value_pool.push_back(last_value);
+    last_value = node->slot >= 0 ? local(node->slot) : Value();
 }
-void Interpreter::visit(FloatLiteralNode *node)
-{
-    last_value = new FloatValue(node->value);
-    value_pool.push_back(last_value);
-}
-void Interpreter::visit(CharLiteralNode *node)
-{
-    last_value = new CharValue(node->value);
-    value_pool.push_back(last_value);
-}
-void Interpreter::visit(BoolLiteralNode *node)
-{
-    last_value = new BoolValue(node->value);
-    value_pool.push_back(last_value);
-}
-void Interpreter::visit(VarAccessNode *node) { last_value = get_variable(node->name); }
 void Interpreter::visit(UnaryOpNode *node)
 {
     node->expr->accept(this);
 
+    // Especializado: só confere a tag (nil cai no caminho genérico, como na VM).
+    switch (node->spec)
+    {
+    case UnarySpec::INT_NEG:
+        if (last_value.is_int())
+        {
+            last_value.i = -last_value.i;
+            return;
+        }
+        break;
+    case UnarySpec::FLOAT_NEG:
+        if (last_value.is_float())
+        {
+            last_value.f = -last_value.f;
+            return;
+        }
+        break;
+    case UnarySpec::BOOL_NOT:
+        if (last_value.is_bool())
+        {
+            last_value.b = !last_value.b;
+            return;
+        }
+        break;
+    case UnarySpec::GENERIC:
+        break;
+    }
+
     switch (node->op)
     {
     case '!':
     {
-        if (auto *bv = dynamic_cast<BoolValue *>(last_value))
+        if (last_value.is_bool())
         {
-            last_value = new BoolValue(!bv->value);
-            value_pool.push_back(last_value);
+            last_value.b = !last_value.b;
         }
         break;
     }
     case '-':
     {
-        if (auto *iv = dynamic_cast<IntValue *>(last_value))
+        if (last_value.is_int())
         {
-            last_value = new IntValue(-iv->value);
+            last_value.i = -last_value.i;
         }
-        else if (auto *fv = dynamic_cast<FloatValue *>(last_value))
+        else if (last_value.is_float())
         {
-            last_value = new FloatValue(-fv->value);
+            last_value.f = -last_value.f;
         }
         else
         {
             throw std::runtime_error("Operador unário '-' requer Int ou Float");
         }
-        value_pool.push_back(last_value);
         break;
     }
     }
 }
 
-void Interpreter::visit(BinaryOpNode *node)
+namespace
 {
-    // Avalia os operandos esquerdo e direito
-    node->left->accept(this);
-    Value *left_val = last_value;
-
-    node->right->accept(this);
-    Value *right_val = last_value;
-
-    Value *result_val = nullptr;
-
-    // --- BLOCO 1: Tratamento de Igualdade (==) e Desigualdade (!=) ---
-    // Esta lógica é especial porque precisa funcionar para ponteiros (null) e valores.
-    if (node->op == '=' || node->op == 'n')
+    // Regras de todos os operadores binários, decididas pelos valores.
+    Value binary_generic(char op, const Value &left_val, const Value &right_val)
     {
-        bool are_equal;
-
-        // Primeiro, o caso mais geral: um dos lados é null. Comparamos os ponteiros.
-        if (left_val == nullptr || right_val == nullptr)
+        // --- BLOCO 1: Tratamento de Igualdade (==) e Desigualdade (!=) ---
+        // Primitivos comparam o conteúdo; null, registros e arrays comparam a referência.
+        if (op == '=' || op == 'n')
         {
-            are_equal = (left_val == right_val);
+            bool are_equal = left_val.equals(right_val);
+            return Value::make_bool((op == '=') ? are_equal : !are_equal);
         }
-        // Se ambos não são nulos, tentamos uma comparação de valor mais específica.
-        else
+
+        // --- BLOCO 2: Tratamento de Operadores Numéricos e Relacionais ---
+        bool li = left_val.is_int(), ri = right_val.is_int();
+        bool lf = left_val.is_float(), rf = right_val.is_float();
+
+        if (li && ri)
         {
-            auto li = dynamic_cast<IntValue *>(left_val);
-            auto ri = dynamic_cast<IntValue *>(right_val);
-            if (li && ri)
+            int l = left_val.i, r = right_val.i;
+            switch (op)
             {
-                are_equal = (li->value == ri->value);
+            case '+':
+                return Value::make_int(l + r);
+            case '-':
+                return Value::make_int(l - r);
+            case '*':
+                return Value::make_int(l * r);
+            case '/':
+                return Value::make_int(l / r);
+            case '%':
+                return Value::make_int(l % r);
+            case '<':
+                return Value::make_bool(l < r);
+            case '>':
+                return Value::make_bool(l > r);
             }
-            else
+        }
+        else if ((li || lf) && (ri || rf))
+        {
+            // Promoção Int → Float quando pelo menos um dos lados é Float.
+            float l = lf ? left_val.f : static_cast<float>(left_val.i);
+            float r = rf ? right_val.f : static_cast<float>(right_val.i);
+            switch (op)
             {
-                auto lf = dynamic_cast<FloatValue *>(left_val);
-                auto rf = dynamic_cast<FloatValue *>(right_val);
-                if (lf && rf)
-                {
-                    are_equal = (lf->value == rf->value);
-                }
-                else
-                {
-                    auto lb = dynamic_cast<BoolValue *>(left_val);
-                    auto rb = dynamic_cast<BoolValue *>(right_val);
-                    if (lb && rb)
-                    {
-                        are_equal = (lb->value == rb->value);
-                    }
-                    else
-                    {
-                        auto lc = dynamic_cast<CharValue *>(left_val);
-                        auto rc = dynamic_cast<CharValue *>(right_val);
-                        if (lc && rc)
-                        {
-                            are_equal = (lc->value == rc->value);
-                        }
-                        else
-                        {
-                            // Para tipos complexos (Record, Array), comparamos o endereço de memória.
-                            are_equal = (left_val == right_val);
-                        }
-                    }
-                }
+            case '+':
+                return Value::make_float(l + r);
+            case '-':
+                return Value::make_float(l - r);
+            case '*':
+                return Value::make_float(l * r);
+            case '/':
+                return Value::make_float(l / r);
+            case '<':
+                return Value::make_bool(l < r);
+            case '>':
+                return Value::make_bool(l > r);
             }
         }
+        else if (op == '&' && left_val.is_bool() && right_val.is_bool()) // Operador lógico '&&'
+        {
+            return Value::make_bool(left_val.b && right_val.b);
+        }
 
-        bool final_result = (node->op == '=') ? are_equal : !are_equal;
-        result_val = new BoolValue(final_result);
+        // Se nenhuma regra funcionou, os tipos são incompatíveis para a operação.
+        throw std::runtime_error("Erro de Execução: Operação binária entre tipos incompatíveis.");
     }
-    // --- BLOCO 2: Tratamento de Operadores Numéricos e Relacionais ---
-    else
-    {
-        // Converte os operandos para os tipos numéricos que nos interessam.
-        auto li = dynamic_cast<IntValue *>(left_val);
-        auto ri = dynamic_cast<IntValue *>(right_val);
-        auto lf = dynamic_cast<FloatValue *>(left_val);
-        auto rf = dynamic_cast<FloatValue *>(right_val);
-
-        auto toFloat = [](IntValue *v)
-        { return static_cast<float>(v->value); };
+}
 
-        switch (node->op)
-        {
-        case '+':
-            if (li && ri)
-                result_val = new IntValue(li->value + ri->value);
-            else if (lf && rf)
-                result_val = new FloatValue(lf->value + rf->value);
-            else if (li && rf)
-                result_val = new FloatValue(toFloat(li) + rf->value);
-            else if (lf && ri)
-                result_val = new FloatValue(lf->value + toFloat(ri));
-            break;
-        case '-':
-            if (li && ri)
-                result_val = new IntValue(li->value - ri->value);
-            else if (lf && rf)
-                result_val = new FloatValue(lf->value - rf->value);
-            else if (li && rf)
-                result_val = new FloatValue(toFloat(li) - rf->value);
-            else if (lf && ri)
-                result_val = new FloatValue(lf->value - toFloat(ri));
-            break;
-        case '*':
-            if (li && ri)
-                result_val = new IntValue(li->value * ri->value);
-            else if (lf && rf)
-                result_val = new FloatValue(lf->value * rf->value);
-            else if (li && rf)
-                result_val = new FloatValue(toFloat(li) * rf->value);
-            else if (lf && ri)
-                result_val = new FloatValue(lf->value * toFloat(ri));
-            break;
-        case '/':
-            if (li && ri)
-                result_val = new IntValue(li->value / ri->value);
-            else if (lf && rf)
-                result_val = new FloatValue(lf->value / rf->value);
-            else if (li && rf)
-                result_val = new FloatValue(toFloat(li) / rf->value);
-            else if (lf && ri)
-                result_val = new FloatValue(lf->value / toFloat(ri));
-            break;
-        case '%':
-            if (li && ri)
-                result_val = new IntValue(li->value % ri->value);
-            break;
-        case '<':
-            if (li && ri)
-                result_val = new BoolValue(li->value < ri->value);
-            else if (lf && rf)
-                result_val = new BoolValue(lf->value < rf->value);
-            else if (li && rf)
-                result_val = new BoolValue(toFloat(li) < rf->value);
-            else if (lf && ri)
-                result_val = new BoolValue(lf->value < toFloat(ri));
-            break;
-        case '>':
-            if (li && ri)
-                result_val = new BoolValue(li->value > ri->value);
-            else if (lf && rf)
-                result_val = new BoolValue(lf->value > rf->value);
-            else if (li && rf)
-                result_val = new BoolValue(toFloat(li) > rf->value);
-            else if (lf && ri)
-                result_val = new BoolValue(lf->value > toFloat(ri));
-            break;
-        case '&': // Operador lógico '&&'
-            auto lb = dynamic_cast<BoolValue *>(left_val);
-            auto rb = dynamic_cast<BoolValue *>(right_val);
-            if (lb && rb)
-                result_val = new BoolValue(lb->value && rb->value);
-            break;
-        }
+// Operação já tipada pelo TypeChecker: os operandos são primitivos do tipo
+// esperado ou nil (função sem return, por exemplo). Só a tag é conferida;
+// nil vai para binary_generic, que dá o mesmo resultado ou erro da VM. O
+// operando esquerdo não precisa de raiz durante a avaliação do direito.
+#define SPECIALIZED(SPEC, KIND, FIELD, MAKE, EXPR)                                \
+    case BinarySpec::SPEC:                                                        \
+    {                                                                             \
+        node->left->accept(this);                                                 \
+        Value left_val = last_value;                                              \
+        node->right->accept(this);                                                \
+        if (left_val.kind != ValueKind::KIND || last_value.kind != ValueKind::KIND) \
+        {                                                                         \
+            last_value = binary_generic(node->op, left_val, last_value);          \
+            return;                                                               \
+        }                                                                         \
+        auto l = left_val.FIELD;                                                  \
+        auto r = last_value.FIELD;                                                \
+        last_value = Value::MAKE(EXPR);                                           \
+        return;                                                                   \
     }
 
-    // --- Finalização ---
-    if (result_val)
-    {
-        last_value = result_val;
-        value_pool.push_back(result_val);
+void Interpreter::visit(BinaryOpNode *node)
+{
+    switch (node->spec)
+    {
+        SPECIALIZED(INT_ADD, INT, i, make_int, l + r)
+        SPECIALIZED(INT_SUB, INT, i, make_int, l - r)
+        SPECIALIZED(INT_MUL, INT, i, make_int, l * r)
+        SPECIALIZED(INT_DIV, INT, i, make_int, l / r)
+        SPECIALIZED(INT_MOD, INT, i, make_int, l % r)
+        SPECIALIZED(INT_LT, INT, i, make_bool, l < r)
+        SPECIALIZED(INT_GT, INT, i, make_bool, l > r)
+        SPECIALIZED(INT_EQ, INT, i, make_bool, l == r)
+        SPECIALIZED(INT_NE, INT, i, make_bool, l != r)
+        SPECIALIZED(FLOAT_ADD, FLOAT, f, make_float, l + r)
+        SPECIALIZED(FLOAT_SUB, FLOAT, f, make_float, l - r)
+        SPECIALIZED(FLOAT_MUL, FLOAT, f, make_float, l * r)
+        SPECIALIZED(FLOAT_DIV, FLOAT, f, make_float, l / r)
+        SPECIALIZED(FLOAT_LT, FLOAT, f, make_bool, l < r)
+        SPECIALIZED(FLOAT_GT, FLOAT, f, make_bool, l > r)
+        SPECIALIZED(FLOAT_EQ, FLOAT, f, make_bool, l == r)
+        SPECIALIZED(FLOAT_NE, FLOAT, f, make_bool, l != r)
+        SPECIALIZED(CHAR_EQ, CHAR, c, make_bool, l == r)
+        SPECIALIZED(CHAR_NE, CHAR, c, make_bool, l != r)
+        SPECIALIZED(BOOL_EQ, BOOL, b, make_bool, l == r)
+        SPECIALIZED(BOOL_NE, BOOL, b, make_bool, l != r)
+        SPECIALIZED(BOOL_AND, BOOL, b, make_bool, l && r)
+    case BinarySpec::GENERIC:
+        break;
     }
-    else
+
+    // Avalia os operandos esquerdo e direito
+    node->left->accept(this);
+    Value left_val = last_value;
+
     {
-        // Se nenhuma regra funcionou, os tipos são incompatíveis para a operação.
-        throw std::runtime_error("Erro de Execução: Operação binária entre tipos incompatíveis.");
+        TempRoot left_root(temp_roots, left_val);
+        node->right->accept(this);
     }
+    last_value = binary_generic(node->op, left_val, last_value);
 }
+#undef SPECIALIZED
 void Interpreter::visit(TypeNode *node) {}
 
 void Interpreter::visit(NullLiteralNode * /*node*/)
 {
-    last_value = nullptr; // ou um NullValue*, se preferir
+    last_value = Value(); // null
 }
 
 void Interpreter::visit(ArrayAccessNode *node)
 {
     node->array_expr->accept(this);
-    auto *arr_val = dynamic_cast<ArrayValue *>(last_value);
+    auto *arr_val = last_value.is_array() ? last_value.as_array() : nullptr;
     if (!arr_val)
     {
         // Lança um erro claro em vez de retornar em silêncio
         throw std::runtime_error("Erro de execução: tentativa de indexar um tipo que não é um array.");
     }
 
+    TempRoot arr_root(temp_roots, last_value);
     node->index_expr->accept(this);
-    auto *idx_val = dynamic_cast<IntValue *>(last_value);
-    if (!idx_val)
+    if (!last_value.is_int())
     {
         throw std::runtime_error("Erro de execução: o índice de um array deve ser do tipo Int.");
     }
 
-    if (idx_val->value < 0 || idx_val->value >= arr_val->elements.size())
+    int index = last_value.i;
+    if (index < 0 || (size_t)index >= arr_val->size())
     {
         // Erro de "out-of-bounds"
-        throw std::runtime_error("Erro de execução: Índice de array (" + std::to_string(idx_val->value) + ") fora dos limites [0, " + std::to_string(arr_val->elements.size() - 1) + "].");
+        throw std::runtime_error("Erro de execução: Índice de array (" + std::to_string(index) + ") fora dos limites [0, " + std::to_string((long)arr_val->size() - 1) + "].");
     }
 
-    last_value = arr_val->elements[idx_val->value];
+    last_value = arr_val->get(index);
 }
\ No newline at end of file
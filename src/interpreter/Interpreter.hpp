@@ -3,14 +3,20 @@
 
 // Includes que faltavam
 #include <cstddef> // Para o tipo size_t
-#include <map>
+#include <iosfwd>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <set>
 
 // Headers do seu projeto
 #include "../ast/Visitor.hpp"
 #include "../runtime/Value.hpp"
+#include "../runtime/Heap.hpp"
+#include "../runtime/MemoCache.hpp"
+#include "../runtime/MemStats.hpp"
+#include "../runtime/NativeStack.hpp"
+#include "../runtime/RecordValue.hpp"
 
 // Forward declarations para os nós da AST usados nos parâmetros
 // Isso avisa ao compilador que essas classes existem, sem precisar incluir o header inteiro.
@@ -18,32 +24,105 @@ class TypeNode;
 class Expression;
 class FunDefNode;
 class DataDefNode;
+class FieldAccessNode;
+class ArrayAccessNode;
+class ArrayValue;
+class Command;
+class Profiler;
+
+// Configuração do interpretador vinda da linha de comando.
+struct InterpreterOptions
+{
+    std::size_t gc_threshold = Heap::DEFAULT_THRESHOLD; // --gc-threshold
+    std::size_t max_stack = DEFAULT_MAX_STACK;          // --max-stack
+    std::size_t memoize = 0; // --memoize[=N]: entradas por função pura (0 desliga)
+    std::size_t mem_stats_every = 0; // --mem-stats=N: estado da memória a cada N coletas
+};
 
 class Interpreter : public Visitor
 {
 private:
-    std::vector<std::map<std::string, Value *>> memory_stack;
-    std::map<std::string, FunDefNode *> functions;
-    std::map<std::string, DataDefNode *> data_types;
-    Value *last_value = nullptr;
-    std::vector<Value *> value_pool;
-
-    void push_scope();
-    void pop_scope();
-    void set_variable(const std::string &name, Value *value, bool is_decl = false);
-    void update_variable(const std::string &name, Value *new_value_obj);
-    Value *get_variable(const std::string &name);
+    // Slots de todas as chamadas ativas, em sequência. O frame atual começa
+    // em frame_base; os índices de cada variável vêm do Resolver.
+    std::vector<Value> frame_slots;
+    std::size_t frame_base = 0;
+    SymbolMap<FunDefNode *> functions;
+    SymbolMap<DataDefNode *> data_types;
+    // Descrição de cada tipo 'data', apontada pelas suas instâncias.
+    SymbolMap<std::shared_ptr<RecordShape>> record_shapes;
+    Value last_value;
+    // Registros e arrays vivem no heap coletado; primitivos são "unboxed".
+    Heap heap;
+    // Valores intermediários ainda não guardados em variáveis (operandos,
+    // argumentos, retornos em trânsito). São raízes para o coletor.
+    std::vector<Value> temp_roots;
+
+    void collect_garbage();
+    // Ponto seguro: coleta se o heap passou do limiar.
+    void maybe_collect()
+    {
+        if (heap.needs_collection())
+            collect_garbage();
+    }
+
+    // Valores do último 'return' executado, reaproveitado entre chamadas:
+    // o chamador os consome logo após a volta. 'returning' fica ligado
+    // enquanto blocos e laços são abandonados até a chamada corrente.
+    std::vector<Value> return_values;
+    bool returning = false;
+    // Destino de um `return g(...)[0]` em posição de cauda (ReturnCmdNode::
+    // tail_call): os argumentos de g ficam em return_values e call_function
+    // executa g no mesmo frame, sem aumentar a pilha.
+    FunDefNode *tail_target = nullptr;
+
+    // Chamadas ativas (sem contar as de cauda), limitadas por --max-stack.
+    // A recursão da linguagem usa a pilha nativa, reservada em interpret()
+    // para max_stack chamadas; native_floor é o endereço a partir do qual
+    // ela está perto de acabar (corpos muito aninhados gastam mais, e a
+    // reserva pode ter saído menor por falta de memória).
+    std::size_t max_stack;
+    std::size_t call_depth = 0;
+    const char *native_floor = nullptr;
+
+    // --memoize: resultados das funções memoizable, por função.
+    std::size_t memo_capacity;
+    std::unordered_map<const FunDefNode *, MemoCache> memo;
+
+    // --mem-stats: pilha de frames (o heap tem as próprias contas).
+    StackStats stack_stats;
+    std::size_t mem_stats_every;
+
+    // --profile: recebe as chamadas e os comandos executados (nulo se desligado).
+    Profiler *profiler = nullptr;
+    void profile_line(Command *cmd);
+
+    Value &local(int slot) { return frame_slots[frame_base + slot]; }
+    // Avalia os argumentos, executa o corpo num frame novo (e, no mesmo
+    // frame, as chamadas de cauda que ele fizer) e deixa os valores
+    // retornados em return_values. Devolve false se a aridade não bater
+    // (a função não é executada).
+    bool call_function(FunDefNode *func_def, const std::vector<Expression *> &args);
+
+    // Destinos de atribuição e de `read` (p.x, a[i]): avaliam o registro ou
+    // o array e o índice, com as verificações de execução.
+    Value &field_target(FieldAccessNode *fa);
+    ArrayValue *element_target(ArrayAccessNode *aa, int &index);
 
     // --- Métodos Auxiliares para Arrays/Matrizes ---
-    Value *create_default_value(TypeNode *type, std::set<std::string> &visited_records);
-    Value *create_nested_array(TypeNode *base_elem_type,
-                               const std::vector<Expression *> &dims,
-                               size_t dim_index);
+    Value create_default_value(TypeNode *type, std::vector<Symbol> &visited_records);
+    Value create_nested_array(TypeNode *base_elem_type,
+                              const std::vector<Expression *> &dims,
+                              size_t dim_index);
 
 public:
+    explicit Interpreter(const InterpreterOptions &options = InterpreterOptions());
     ~Interpreter();
+    const Heap &get_heap() const { return heap; }
+    const StackStats &get_stack_stats() const { return stack_stats; }
+    void print_memo_stats(std::ostream &os) const;
+    void set_profiler(Profiler *p) { profiler = p; }
     void interpret(ProgramNode *ast);
-    Value *create_default_value(TypeNode *type);
+    Value create_default_value(TypeNode *type);
 
     // Métodos visit() ...
     void visit(ProgramNode *node) override;
@@ -0,0 +1,158 @@
+#include "Profiler.hpp"
+#include "../ast/FunDefNode.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+Profiler::Profiler()
+{
+    contexts.push_back(Context{0, 0});
+    start = last = Clock::now();
+}
+
+std::uint32_t Profiler::function_id(const FunDefNode *fn)
+{
+    auto it = function_ids.find(fn);
+    if (it != function_ids.end())
+        return it->second;
+    std::uint32_t id = static_cast<std::uint32_t>(functions.size());
+    functions.push_back(FunctionStats{fn});
+    function_ids.emplace(fn, id);
+    return id;
+}
+
+std::uint32_t Profiler::context_of(std::uint32_t parent, std::uint32_t function)
+{
+    std::uint64_t key = (static_cast<std::uint64_t>(parent) << 32) | function;
+    auto it = context_ids.find(key);
+    if (it != context_ids.end())
+        return it->second;
+    std::uint32_t id = static_cast<std::uint32_t>(contexts.size());
+    contexts.push_back(Context{function, parent});
+    context_ids.emplace(key, id);
+    return id;
+}
+
+void Profiler::charge(Clock::time_point now)
+{
+    std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+    last = now;
+    if (stack.empty())
+        return;
+    Context &ctx = contexts[stack.back()];
+    ctx.self_ns += ns;
+    functions[ctx.function].exclusive_ns += ns;
+}
+
+void Profiler::open(std::uint32_t function, Clock::time_point now)
+{
+    FunctionStats &stats = functions[function];
+    ++stats.calls;
+    if (stats.active++ == 0)
+        stats.outer_start = now;
+    // Recursão direta fica no mesmo contexto: a pilha "collapsed" não
+    // cresce com a profundidade (f;f;f;... vira f).
+    std::uint32_t parent = stack.empty() ? 0 : stack.back();
+    if (parent != 0 && contexts[parent].function == function)
+        stack.push_back(parent);
+    else
+        stack.push_back(context_of(parent, function));
+}
+
+void Profiler::close(Clock::time_point now)
+{
+    FunctionStats &stats = functions[contexts[stack.back()].function];
+    if (--stats.active == 0)
+        stats.inclusive_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(now - stats.outer_start).count();
+    stack.pop_back();
+}
+
+void Profiler::enter(const FunDefNode *fn)
+{
+    std::uint32_t id = function_id(fn);
+    Clock::time_point now = Clock::now();
+    charge(now);
+    open(id, now);
+}
+
+void Profiler::leave()
+{
+    Clock::time_point now = Clock::now();
+    charge(now);
+    close(now);
+}
+
+void Profiler::replace(const FunDefNode *fn)
+{
+    std::uint32_t id = function_id(fn);
+    Clock::time_point now = Clock::now();
+    charge(now);
+    // O contexto de g fica sob o chamador de f, como numa chamada comum de g.
+    close(now);
+    open(id, now);
+}
+
+void Profiler::finish()
+{
+    Clock::time_point now = Clock::now();
+    charge(now);
+    while (!stack.empty())
+        close(now);
+    total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+}
+
+void Profiler::print_flat(std::ostream &os, std::size_t max_lines) const
+{
+    std::vector<const FunctionStats *> order;
+    for (const FunctionStats &stats : functions)
+        order.push_back(&stats);
+    std::sort(order.begin(), order.end(), [](const FunctionStats *a, const FunctionStats *b)
+              { return a->exclusive_ns > b->exclusive_ns; });
+
+    auto ms = [](std::uint64_t ns)
+    { return static_cast<double>(ns) / 1e6; };
+    double total = static_cast<double>(std::max<std::uint64_t>(total_ns, 1));
+
+    os << "[profile] tempo total: " << std::fixed << std::setprecision(3) << ms(total_ns) << " ms\n"
+       << "[profile]  excl.%   exclusivo(ms)   inclusivo(ms)     chamadas  função\n";
+    for (const FunctionStats *stats : order)
+    {
+        os << "[profile] " << std::setw(6) << std::setprecision(2) << 100.0 * stats->exclusive_ns / total << "%"
+           << std::setw(16) << std::setprecision(3) << ms(stats->exclusive_ns)
+           << std::setw(16) << ms(stats->inclusive_ns)
+           << std::setw(13) << stats->calls << "  " << stats->fn->name;
+        if (stats->fn->loc.line > 0)
+            os << " (linha " << stats->fn->loc.line << ')';
+        os << '\n';
+    }
+
+    std::vector<std::pair<std::uint64_t, int>> lines;
+    for (std::size_t line = 0; line < line_hits.size(); ++line)
+        if (line_hits[line] > 0)
+            lines.emplace_back(line_hits[line], static_cast<int>(line));
+    std::sort(lines.begin(), lines.end(), [](const auto &a, const auto &b)
+              { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+    if (lines.size() > max_lines)
+        lines.resize(max_lines);
+    if (!lines.empty())
+        os << "[profile] linhas mais executadas:\n";
+    for (const auto &entry : lines)
+        os << "[profile]   linha " << std::setw(6) << entry.second << ": " << entry.first << '\n';
+    os << std::defaultfloat << std::setprecision(6);
+}
+
+void Profiler::write_folded(std::ostream &os) const
+{
+    std::vector<std::string> names(contexts.size());
+    for (std::size_t id = 1; id < contexts.size(); ++id)
+    {
+        // Os pais são sempre criados antes dos filhos.
+        const Context &ctx = contexts[id];
+        const std::string &fn = functions[ctx.function].fn->name;
+        names[id] = ctx.parent == 0 ? fn : names[ctx.parent] + ';' + fn;
+        std::uint64_t us = ctx.self_ns / 1000;
+        if (us > 0)
+            os << names[id] << ' ' << us << '\n';
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+class FunDefNode;
+
+// Perfil de execução do interpretador (--profile), por instrumentação: o
+// Interpreter avisa a entrada e a saída de cada chamada e cada comando
+// executado. Mede, por função, as chamadas e os tempos inclusivo (com as
+// chamadas feitas por ela, sem contar duas vezes a recursão) e exclusivo,
+// e conta quantas vezes cada linha foi executada.
+//
+// O tempo exclusivo também é acumulado por pilha de chamadas, numa árvore
+// de contextos (a recursão direta não aprofunda a árvore), e sai no formato
+// "collapsed" (main;f;g <microssegundos>) aceito por flamegraph.pl,
+// speedscope e ferramentas parecidas.
+class Profiler
+{
+public:
+    Profiler();
+
+    void enter(const FunDefNode *fn);
+    void leave();
+    // Chamada de cauda: fn substitui a função do topo da pilha.
+    void replace(const FunDefNode *fn);
+    void hit(int line)
+    {
+        if (line <= 0)
+            return;
+        if (static_cast<std::size_t>(line) >= line_hits.size())
+            line_hits.resize(line + 1);
+        ++line_hits[line];
+    }
+
+    // Encerra as chamadas ainda abertas (ex.: após um erro de execução).
+    void finish();
+
+    // Tabela por função, ordenada pelo tempo exclusivo, e as linhas mais executadas.
+    void print_flat(std::ostream &os, std::size_t max_lines = 20) const;
+    void write_folded(std::ostream &os) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct FunctionStats
+    {
+        const FunDefNode *fn = nullptr;
+        std::uint64_t calls = 0;
+        std::uint64_t inclusive_ns = 0;
+        std::uint64_t exclusive_ns = 0;
+        std::uint32_t active = 0;        // chamadas abertas (recursão)
+        Clock::time_point outer_start{}; // entrada da chamada aberta mais externa
+    };
+    // Nó da árvore de contextos: uma função chamada a partir de 'parent'.
+    struct Context
+    {
+        std::uint32_t function;
+        std::uint32_t parent;
+        std::uint64_t self_ns = 0;
+    };
+
+    std::vector<FunctionStats> functions;
+    std::unordered_map<const FunDefNode *, std::uint32_t> function_ids;
+    std::vector<Context> contexts; // contexts[0] é a raiz, sem função
+    std::unordered_map<std::uint64_t, std::uint32_t> context_ids; // (parent, função) -> contexto
+    std::vector<std::uint32_t> stack; // contextos das chamadas abertas
+    std::vector<std::uint64_t> line_hits;
+    Clock::time_point start;
+    Clock::time_point last; // último evento: o tempo desde ele é do topo da pilha
+    std::uint64_t total_ns = 0;
+
+    std::uint32_t function_id(const FunDefNode *fn);
+    std::uint32_t context_of(std::uint32_t parent, std::uint32_t function);
+    // Atribui ao topo da pilha o tempo desde o último evento.
+    void charge(Clock::time_point now);
+    void open(std::uint32_t function, Clock::time_point now);
+    void close(Clock::time_point now);
+};
+
+#endif
@@ -0,0 +1,268 @@
+#include "Lexer.hpp"
+#include "parser.tab.hpp"
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// --- SourceFile ---
+
+SourceFile::~SourceFile()
+{
+    if (mapping)
+        ::munmap(mapping, length);
+}
+
+bool SourceFile::open(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
+        {
+            ::close(fd);
+            mapping = p;
+            first = static_cast<const char *>(p);
+            length = static_cast<std::size_t>(st.st_size);
+            return true;
+        }
+    }
+
+    char buffer[64 * 1024];
+    for (;;)
+    {
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+        {
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            return false;
+        }
+        if (n == 0)
+            break;
+        contents.append(buffer, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+    first = contents.data();
+    length = contents.size();
+    return true;
+}
+
+// --- Lexer ---
+
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+static bool is_lower(char c) { return c >= 'a' && c <= 'z'; }
+static bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+static bool is_ident(char c) { return is_lower(c) || is_upper(c) || is_digit(c) || c == '_'; }
+static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static int keyword(std::string_view word)
+{
+    static const struct
+    {
+        std::string_view text;
+        int kind;
+    } KEYWORDS[] = {
+        {"print", T_PRINT}, {"read", T_READ}, {"return", T_RETURN}, {"if", T_IF},
+        {"else", T_ELSE}, {"true", T_TRUE}, {"false", T_FALSE}, {"iterate", T_ITERATE},
+        {"data", T_DATA}, {"new", T_NEW}, {"Int", T_TYPE_INT}, {"Bool", T_TYPE_BOOL},
+        {"Char", T_TYPE_CHAR}, {"Float", T_TYPE_FLOAT}, {"Void", T_TYPE_VOID}, {"null", T_NULL}};
+    if (word.size() > 7)
+        return 0;
+    for (const auto &kw : KEYWORDS)
+        if (kw.text == word)
+            return kw.kind;
+    return 0;
+}
+
+void Lexer::advance(const char *to)
+{
+    for (; pos < to; ++pos)
+        if (*pos == '\n')
+        {
+            ++lineno;
+            line_start = pos + 1;
+        }
+}
+
+void Lexer::skip_whitespace()
+{
+    while (pos < limit && is_space(*pos))
+    {
+        if (*pos == '\n')
+        {
+            ++lineno;
+            line_start = pos + 1;
+        }
+        ++pos;
+    }
+}
+
+int Lexer::take(std::size_t size, int kind)
+{
+    token = pos;
+    token_size = size;
+    token_lineno = lineno;
+    token_column = static_cast<std::size_t>(pos - line_start) + 1;
+    pos += size;
+    return kind;
+}
+
+int Lexer::next(YYSTYPE &value)
+{
+    if (after_rparen)
+    {
+        after_rparen = false;
+        skip_whitespace();
+        if (pos < limit && *pos == '<')
+            return take(1, LT_CAPTURE);
+    }
+
+    for (;;)
+    {
+        skip_whitespace();
+        if (pos >= limit)
+        {
+            token = pos;
+            token_size = 0;
+            token_lineno = lineno;
+            token_column = static_cast<std::size_t>(pos - line_start) + 1;
+            return 0;
+        }
+
+        const char c = pos[0];
+        const std::size_t left = static_cast<std::size_t>(limit - pos);
+        const char c1 = left > 1 ? pos[1] : '\0';
+
+        // Comentários: // e -- até o fim da linha, {- ... -} em bloco.
+        if ((c == '/' && c1 == '/') || (c == '-' && c1 == '-'))
+        {
+            const char *eol = static_cast<const char *>(std::memchr(pos, '\n', left));
+            pos = eol ? eol : limit;
+            continue;
+        }
+        if (c == '{' && c1 == '-')
+        {
+            const char *close = pos + 2;
+            while (close + 1 < limit && !(close[0] == '-' && close[1] == '}'))
+                ++close;
+            advance(close + 1 < limit ? close + 2 : limit);
+            continue;
+        }
+
+        if (is_lower(c) || is_upper(c))
+        {
+            const char *e = pos + 1;
+            while (e < limit && is_ident(*e))
+                ++e;
+            std::string_view word(pos, static_cast<std::size_t>(e - pos));
+            if (int kind = keyword(word))
+                return take(word.size(), kind);
+            value.sym = Symbol::intern(word);
+            return take(word.size(), is_upper(c) ? T_TYID : T_ID);
+        }
+
+        if (is_digit(c))
+        {
+            const char *e = pos;
+            long n = 0;
+            for (; e < limit && is_digit(*e); ++e)
+                n = n > (LONG_MAX - (*e - '0')) / 10 ? LONG_MAX : n * 10 + (*e - '0');
+            if (e + 1 < limit && *e == '.' && is_digit(e[1]))
+            {
+                for (e += 2; e < limit && is_digit(*e); ++e)
+                {
+                }
+                double d = 0.0;
+                if (std::from_chars(pos, e, d).ec == std::errc::result_out_of_range)
+                    d = HUGE_VAL; // como o atof do lexer antigo
+                value.fval = static_cast<float>(d);
+                return take(static_cast<std::size_t>(e - pos), T_FLOAT_LITERAL);
+            }
+            value.ival = static_cast<int>(n);
+            return take(static_cast<std::size_t>(e - pos), T_INT_LITERAL);
+        }
+
+        // 'x' ou '\x': o valor é o caractere logo após a aspa.
+        if (c == '\'')
+        {
+            if (left > 2 && c1 != '\'' && c1 != '\\' && pos[2] == '\'')
+            {
+                value.cval = c1;
+                if (c1 == '\n')
+                {
+                    // O literal começa na linha de cima; a próxima começa no fecha-aspas.
+                    int kind = take(3, T_CHAR_LITERAL);
+                    ++lineno;
+                    line_start = pos - 1;
+                    return kind;
+                }
+                return take(3, T_CHAR_LITERAL);
+            }
+            if (left > 3 && c1 == '\\' && pos[2] != '\n' && pos[3] == '\'')
+            {
+                value.cval = c1;
+                return take(4, T_CHAR_LITERAL);
+            }
+        }
+
+        switch (c)
+        {
+        case ':':
+            return c1 == ':' ? take(2, T_COLON_COLON) : take(1, ':');
+        case '&':
+            if (c1 == '&')
+                return take(2, T_AND);
+            break;
+        case '=':
+            return c1 == '=' ? take(2, T_EQ) : take(1, '=');
+        case '!':
+            return c1 == '=' ? take(2, T_NEQ) : take(1, '!');
+        case ')':
+            after_rparen = true;
+            return take(1, ')');
+        case '<':
+        case ',':
+        case '.':
+        case '>':
+        case '+':
+        case '-':
+        case '*':
+        case '%':
+        case '/':
+        case ';':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case '(':
+            return take(1, c);
+        default:
+            break;
+        }
+
+        take(1, 0);
+        error("Caractere inesperado");
+    }
+}
+
+void Lexer::error(const char *message)
+{
+    ++errors;
+    std::fprintf(stderr, "Erro sintático na linha %d: %s perto do texto '%.*s'\n", lineno, message,
+                 static_cast<int>(token_size), token);
+}
@@ -0,0 +1,83 @@
+#ifndef LEXER_HPP
+#define LEXER_HPP
+#include "../ast/SourceLoc.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Arquivo-fonte inteiro em memória: mapeado com mmap quando é um arquivo
+// comum, lido de uma vez caso contrário (pipes, /dev/stdin).
+class SourceFile
+{
+public:
+    SourceFile() = default;
+    ~SourceFile();
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
+
+    // false se o arquivo não pôde ser aberto (errno indica o motivo).
+    bool open(const std::string &path);
+    const char *begin() const { return first; }
+    const char *end() const { return first + length; }
+
+private:
+    void *mapping = nullptr;
+    std::string contents; // quando não dá para mapear
+    const char *first = nullptr;
+    std::size_t length = 0;
+};
+
+union YYSTYPE;
+
+// Analisador léxico escrito à mão, no lugar do lexer.l do Flex (mesmos
+// tokens e mesmas regras de maior casamento). É reentrante: todo o estado
+// fica no objeto, que percorre um buffer já em memória sem copiar o texto
+// dos tokens. Identificadores e nomes de tipo são internados como Symbol.
+class Lexer
+{
+public:
+    // 'file' é o número do arquivo em register_source_file() (0 se não há arquivo).
+    Lexer(const char *begin, const char *end, uint16_t file = 0)
+        : pos(begin), limit(end), token(begin), line_start(begin), file(file) {}
+
+    // Próximo token para o parser (0 no fim do arquivo).
+    int next(YYSTYPE &value);
+
+    int line() const { return lineno; }
+    // Linha onde começa o último token lido.
+    int token_line() const { return token_lineno; }
+    // Posição (arquivo, linha, coluna) do último token lido.
+    SourceLoc location() const
+    {
+        SourceLoc loc;
+        loc.line = static_cast<uint32_t>(token_lineno);
+        loc.column = static_cast<uint16_t>(token_column < 0xFFFF ? token_column : 0xFFFF);
+        loc.file = file;
+        return loc;
+    }
+    // Texto do último token lido, para as mensagens de erro.
+    std::string_view text() const { return std::string_view(token, token_size); }
+
+    // Imprime o erro na linha e no token atuais e o contabiliza.
+    void error(const char *message);
+    int error_count() const { return errors; }
+
+private:
+    const char *pos;
+    const char *limit;
+    const char *token;
+    std::size_t token_size = 0;
+    const char *line_start; // primeiro caractere da linha atual
+    uint16_t file;
+    int lineno = 1;
+    int token_lineno = 1;
+    std::size_t token_column = 1;
+    int errors = 0;
+    bool after_rparen = false; // um '<' logo após ')' abre a lista de captura
+
+    void skip_whitespace();
+    void advance(const char *to); // consome até 'to', contando as linhas
+    int take(std::size_t size, int kind);
+};
+
+#endif
@@ -1,45 +1,132 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <stdexcept>
 
 #include "typecheck/TypeChecker.hpp"
+#include "typecheck/Resolver.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/EscapeAnalysis.hpp"
+#include "optimizer/PurityAnalysis.hpp"
+#include "ast/AstFile.hpp"
+#include "ast/AstPrinter.hpp"
 #include "ast/ProgramNode.hpp"
 #include "interpreter/Interpreter.hpp"
+#include "interpreter/Profiler.hpp"
+#include "vm/Compiler.hpp"
+#include "vm/ProgramCache.hpp"
+#include "vm/VM.hpp"
+#include "runtime/Output.hpp"
+#include "lexer/Lexer.hpp"
 
-// Símbolos gerados por Flex/Bison
-extern FILE *yyin;
-extern int yyparse();
+// Símbolos gerados pelo Bison
+extern int yyparse(Lexer &lexer, ProgramNode *&ast_root);
 extern int yydebug;
-extern ProgramNode *ast_root;
-extern bool parse_error_detected;
 
 // Enum para representar as ações do compilador
 enum class CompilerAction
 {
     SYNTACTIC_ANALYSIS, // Para a flag -syn
-    INTERPRET           // Para a flag -i
+    INTERPRET,          // Para a flag -i
+    VIRTUAL_MACHINE,    // Para a flag -vm (ou -c)
+    EMIT_AST            // Para a flag -emit-ast
 };
 
+// Checagem de tipos, otimização (-O1), resolução de slots, análise de
+// escape (-O1) e de pureza: comum a -i e -vm.
+static void analyze(ProgramNode *ast, int opt_level)
+{
+    TypeChecker tc;
+    tc.check(ast);
+    if (opt_level > 0)
+        Optimizer().optimize(ast);
+    Resolver().resolve(ast);
+    if (opt_level > 0)
+        EscapeAnalysis().analyze(ast);
+    PurityAnalysis().analyze(ast);
+}
+
+// Executa um programa já compilado na VM; devolve o código de saída.
+static int run_vm(const Program &program, const InterpreterOptions &options, bool gc_stats, bool mem_stats)
+{
+    try
+    {
+        VM vm(program, options.gc_threshold, options.max_stack, options.memoize, options.mem_stats_every);
+        vm.run();
+        Output::standard().flush();
+        if (gc_stats)
+        {
+            vm.get_heap().print_stats(std::cerr);
+            vm.print_memo_stats(std::cerr);
+        }
+        if (mem_stats)
+            print_mem_stats(std::cerr, "vm", vm.get_heap(), vm.get_stack_stats());
+    }
+    catch (const std::exception &e)
+    {
+        // O que o programa imprimiu antes do erro vem antes da mensagem.
+        Output::standard().flush();
+        std::cerr << "Erro: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
 // Função de ajuda
 static void usage(const char *exe)
 {
-    std::cerr << "Uso: " << exe << " [--test] [--debug] <diretiva> <arquivo.lang>\n\n"
+    std::cerr << "Uso: " << exe << " [--test] [--debug] [--gc-stats] [--mem-stats[=N]] [--gc-threshold=N] [--max-stack=N] [--memoize[=N]] [--profile[=ARQ]] [--cache[=DIR]] [-O0|-O1] [--dump-ast] [--unbuffered] <diretiva> <arquivo.lang|arquivo.lbin>\n\n"
               << "Opções:\n"
-              << "  --test   Ativa argumentos falsos para teste (compile com -DFAKE_ARGS).\n"
-              << "  --debug  Habilita o yydebug para traço do parser.\n\n"
+              << "  --test            Ativa argumentos falsos para teste (compile com -DFAKE_ARGS).\n"
+              << "  --debug           Habilita o yydebug para traço do parser.\n"
+              << "  --gc-stats        Imprime em stderr, ao final, as estatísticas do coletor de lixo.\n"
+              << "  --mem-stats[=N]   Imprime em stderr, ao final, as alocações do heap por tipo de\n"
+              << "                    objeto e os picos do heap e da pilha, também em JSON; com N,\n"
+              << "                    emite uma linha JSON com o estado da memória a cada N coletas.\n"
+              << "  --gc-threshold=N  Bytes alocados no heap antes da primeira coleta (padrão 8 MiB).\n"
+              << "  --max-stack=N     Máximo de chamadas ativas (padrão " << DEFAULT_MAX_STACK << "); chamadas\n"
+              << "                    em posição de cauda (`return f(...)[0]`) não contam; até\n"
+              << "                    " << MAX_STACK_LIMIT << ". Com -i, a pilha nativa é reservada para N chamadas\n"
+              << "                    (~2 KiB cada); sem memória para tanto, ela sai menor e o erro avisa.\n"
+              << "  --memoize[=N]     Guarda os resultados das funções puras com parâmetros e\n"
+              << "                    retornos primitivos (até N por função, padrão " << MemoCache::DEFAULT_CAPACITY << ").\n"
+              << "                    Com --gc-stats, imprime também os acertos do cache.\n"
+              << "  --profile[=ARQ]   (-i) Imprime em stderr as chamadas e os tempos de cada função e\n"
+              << "                    as linhas mais executadas; grava as pilhas no formato\n"
+              << "                    \"collapsed\" dos flame graphs em ARQ (padrão lang.folded).\n"
+              << "  --cache[=DIR]     (-vm) Guarda o bytecode compilado em DIR (padrão $LANG_CACHE_DIR,\n"
+              << "                    $XDG_CACHE_HOME/lang ou ~/.cache/lang) e o reaproveita enquanto\n"
+              << "                    o fonte, as opções -O e o executável não mudarem.\n"
+              << "  -O0, -O1          Desliga/liga a dobra de constantes, a poda de ramos e a\n"
+              << "                    alocação em região por chamada (padrão -O1).\n"
+              << "  --dump-ast        Imprime a AST já checada e otimizada e encerra sem executar.\n"
+              << "  --unbuffered      Escreve a saída de `print` a cada linha (o padrão é acumular\n"
+              << "                    num buffer, exceto quando a saída é um terminal).\n\n"
               << "Diretivas disponíveis:\n"
               << "  -syn     Executa apenas a análise sintática e retorna 'accept' ou 'reject'.\n"
-              << "  -i       Interpreta o programa após a checagem de tipos.\n";
+              << "  -i       Interpreta o programa após a checagem de tipos.\n"
+              << "  -vm, -c  Compila o programa para bytecode e o executa na máquina virtual.\n"
+              << "  -emit-ast SAIDA.lbin\n"
+              << "           Grava a AST já checada e otimizada em SAIDA.lbin, sem executar.\n"
+              << "           -i e -vm aceitam o .lbin no lugar do fonte e pulam o parser e a\n"
+              << "           checagem; vale o -O usado na geração.\n";
 }
 
 int main(int argc, char *argv[])
 {
     bool use_fake = false;
     bool enable_debug = false;
+    bool gc_stats = false;
+    bool mem_stats = false;
+    bool dump_ast = false;
+    int opt_level = 1;
+    const char *profile_path = nullptr;
+    std::unique_ptr<ProgramCache> cache;
+    InterpreterOptions itp_options;
 
 #ifdef FAKE_ARGS
     use_fake = true;
@@ -57,6 +144,91 @@ int main(int argc, char *argv[])
         {
             enable_debug = true;
         }
+        else if (std::strcmp(argv[idx], "--gc-stats") == 0)
+        {
+            gc_stats = true;
+        }
+        else if (std::strcmp(argv[idx], "--mem-stats") == 0)
+        {
+            mem_stats = true;
+        }
+        else if (std::strncmp(argv[idx], "--mem-stats=", 12) == 0)
+        {
+            char *end = nullptr;
+            unsigned long long every = std::strtoull(argv[idx] + 12, &end, 10);
+            if (!end || *end != '\0' || every == 0)
+            {
+                std::cerr << "Erro: valor inválido em '" << argv[idx] << "'.\n";
+                return EXIT_FAILURE;
+            }
+            mem_stats = true;
+            itp_options.mem_stats_every = every;
+        }
+        else if (std::strcmp(argv[idx], "-O0") == 0 || std::strcmp(argv[idx], "-O1") == 0)
+        {
+            opt_level = argv[idx][2] - '0';
+        }
+        else if (std::strcmp(argv[idx], "--dump-ast") == 0)
+        {
+            dump_ast = true;
+        }
+        else if (std::strcmp(argv[idx], "--unbuffered") == 0)
+        {
+            Output::standard().set_unbuffered(true);
+        }
+        else if (std::strncmp(argv[idx], "--gc-threshold=", 15) == 0)
+        {
+            char *end = nullptr;
+            unsigned long long bytes = std::strtoull(argv[idx] + 15, &end, 10);
+            if (!end || *end != '\0' || bytes == 0)
+            {
+                std::cerr << "Erro: valor inválido em '" << argv[idx] << "'.\n";
+                return EXIT_FAILURE;
+            }
+            itp_options.gc_threshold = bytes;
+        }
+        else if (std::strcmp(argv[idx], "--profile") == 0)
+        {
+            profile_path = "lang.folded";
+        }
+        else if (std::strncmp(argv[idx], "--profile=", 10) == 0 && argv[idx][10] != '\0')
+        {
+            profile_path = argv[idx] + 10;
+        }
+        else if (std::strcmp(argv[idx], "--cache") == 0)
+        {
+            cache.reset(new ProgramCache(ProgramCache::default_dir()));
+        }
+        else if (std::strncmp(argv[idx], "--cache=", 8) == 0 && argv[idx][8] != '\0')
+        {
+            cache.reset(new ProgramCache(argv[idx] + 8));
+        }
+        else if (std::strcmp(argv[idx], "--memoize") == 0)
+        {
+            itp_options.memoize = MemoCache::DEFAULT_CAPACITY;
+        }
+        else if (std::strncmp(argv[idx], "--memoize=", 10) == 0)
+        {
+            char *end = nullptr;
+            unsigned long long entries = std::strtoull(argv[idx] + 10, &end, 10);
+            if (!end || *end != '\0' || entries == 0)
+            {
+                std::cerr << "Erro: valor inválido em '" << argv[idx] << "'.\n";
+                return EXIT_FAILURE;
+            }
+            itp_options.memoize = entries;
+        }
+        else if (std::strncmp(argv[idx], "--max-stack=", 12) == 0)
+        {
+            char *end = nullptr;
+            unsigned long long calls = std::strtoull(argv[idx] + 12, &end, 10);
+            if (!end || *end != '\0' || calls == 0 || calls > MAX_STACK_LIMIT || argv[idx][12] == '-')
+            {
+                std::cerr << "Erro: valor inválido em '" << argv[idx] << "' (de 1 a " << MAX_STACK_LIMIT << ").\n";
+                return EXIT_FAILURE;
+            }
+            itp_options.max_stack = calls;
+        }
         else
         {
             break;
@@ -101,6 +273,19 @@ int main(int argc, char *argv[])
     {
         action = CompilerAction::INTERPRET;
     }
+    else if (std::strcmp(argv[1], "-vm") == 0 || std::strcmp(argv[1], "-c") == 0)
+    {
+        action = CompilerAction::VIRTUAL_MACHINE;
+    }
+    else if (std::strcmp(argv[1], "-emit-ast") == 0)
+    {
+        if (argc < 4)
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        action = CompilerAction::EMIT_AST;
+    }
     else
     {
         std::cerr << "Erro: Diretiva '" << argv[1] << "' desconhecida.\n\n";
@@ -108,24 +293,66 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    std::string filename = argv[2];
+    if (profile_path && (action == CompilerAction::VIRTUAL_MACHINE || action == CompilerAction::EMIT_AST))
+        std::cerr << "Aviso: --profile só é suportado com -i; ignorado.\n";
+    if (cache && action != CompilerAction::VIRTUAL_MACHINE)
+    {
+        std::cerr << "Aviso: --cache só é suportado com -vm; ignorado.\n";
+        cache.reset();
+    }
 
-    // Abre arquivo
-    yyin = std::fopen(filename.c_str(), "r");
-    if (!yyin)
+    // -emit-ast tem o arquivo de saída antes do fonte.
+    std::string ast_output;
+    if (action == CompilerAction::EMIT_AST)
+        ast_output = argv[2];
+    std::string filename = action == CompilerAction::EMIT_AST ? argv[3] : argv[2];
+
+    // Abre arquivo (mapeado em memória)
+    SourceFile source;
+    if (!source.open(filename))
     {
         std::perror(("Erro ao abrir " + filename).c_str());
         return EXIT_FAILURE;
     }
 
-    // Análise sintática
-    if (yyparse() != 0 || !ast_root || parse_error_detected)
+    // Programa já compilado no cache: não passa pelo parser nem pelo checador.
+    std::uint64_t cache_key = 0;
+    if (cache && !dump_ast)
+    {
+        cache_key = ProgramCache::key_of(filename, std::string_view(source.begin(), source.end() - source.begin()), opt_level);
+        Program program;
+        if (cache->load(cache_key, program))
+            return run_vm(program, itp_options, gc_stats, mem_stats);
+    }
+
+    ProgramNode *ast_root = nullptr;
+    bool analyzed = false;
+    if (AstFile::is_ast_file(source.begin(), source.end()))
+    {
+        // AST gravada por -emit-ast: já passou pelo parser e pela análise.
+        ast_root = AstFile::load(source.begin(), source.end());
+        if (!ast_root)
+        {
+            if (action == CompilerAction::SYNTACTIC_ANALYSIS)
+                std::cout << "reject" << std::endl;
+            else
+                std::cerr << "Erro: '" << filename << "' está corrompido ou foi gerado por outra versão do lang.\n";
+            return EXIT_FAILURE;
+        }
+        analyzed = true;
+    }
+    else
     {
-        if (action == CompilerAction::SYNTACTIC_ANALYSIS)
+        // Análise sintática
+        Lexer lexer(source.begin(), source.end(), register_source_file(filename));
+        if (yyparse(lexer, ast_root) != 0 || !ast_root || lexer.error_count() > 0)
         {
-            std::cout << "reject" << std::endl;
+            if (action == CompilerAction::SYNTACTIC_ANALYSIS)
+            {
+                std::cout << "reject" << std::endl;
+            }
+            return EXIT_FAILURE;
         }
-        return EXIT_FAILURE;
     }
 
     // Ação de análise sintática apenas
@@ -135,22 +362,98 @@ int main(int argc, char *argv[])
         return EXIT_SUCCESS;
     }
 
+    // Checagem de tipos e gravação da AST, sem executar
+    if (action == CompilerAction::EMIT_AST)
+    {
+        try
+        {
+            if (!analyzed)
+                analyze(ast_root, opt_level);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Erro: " << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+        if (!AstFile::store(ast_output, ast_root))
+        {
+            std::perror(("Erro ao gravar " + ast_output).c_str());
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     // Checagem de tipos e interpretação
     if (action == CompilerAction::INTERPRET)
     {
         try
         {
-            TypeChecker tc;
-            tc.check(ast_root);
+            if (!analyzed)
+                analyze(ast_root, opt_level);
+            if (dump_ast)
+            {
+                AstPrinter(std::cout).print(ast_root);
+                return EXIT_SUCCESS;
+            }
 
-            Interpreter itp;
+            Interpreter itp(itp_options);
+            std::unique_ptr<Profiler> profiler;
+            if (profile_path)
+            {
+                profiler.reset(new Profiler());
+                itp.set_profiler(profiler.get());
+            }
             itp.interpret(ast_root);
+            Output::standard().flush();
+            if (profiler)
+            {
+                profiler->finish();
+                profiler->print_flat(std::cerr);
+                std::ofstream folded(profile_path);
+                profiler->write_folded(folded);
+                if (!folded)
+                    std::cerr << "Erro: não foi possível gravar o perfil em '" << profile_path << "'.\n";
+            }
+            if (gc_stats)
+            {
+                itp.get_heap().print_stats(std::cerr);
+                itp.print_memo_stats(std::cerr);
+            }
+            if (mem_stats)
+                print_mem_stats(std::cerr, "interpreter", itp.get_heap(), itp.get_stack_stats());
+        }
+        catch (const std::exception &e)
+        {
+            // O que o programa imprimiu antes do erro vem antes da mensagem.
+            Output::standard().flush();
+            std::cerr << "Erro: " << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Checagem de tipos, compilação para bytecode e execução na VM
+    if (action == CompilerAction::VIRTUAL_MACHINE)
+    {
+        Program program;
+        try
+        {
+            if (!analyzed)
+                analyze(ast_root, opt_level);
+            if (dump_ast)
+            {
+                AstPrinter(std::cout).print(ast_root);
+                return EXIT_SUCCESS;
+            }
+            program = Compiler().compile(ast_root);
         }
         catch (const std::exception &e)
         {
             std::cerr << "Erro: " << e.what() << '\n';
             return EXIT_FAILURE;
         }
+        if (cache && !cache->store(cache_key, program))
+            std::cerr << "Aviso: não foi possível gravar o cache em '" << cache->path_of(cache_key) << "'.\n";
+        return run_vm(program, itp_options, gc_stats, mem_stats);
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,163 @@
+#include "EscapeAnalysis.hpp"
+#include "../ast/AST.hpp"
+
+void EscapeAnalysis::analyze(ProgramNode *ast)
+{
+    if (ast)
+        ast->accept(this);
+}
+
+void EscapeAnalysis::through(Expression *expr)
+{
+    if (expr && !dynamic_cast<VarAccessNode *>(expr))
+        expr->accept(this);
+}
+
+void EscapeAnalysis::visit(ProgramNode *node)
+{
+    for (Node *def : node->definitions)
+        def->accept(this);
+}
+
+void EscapeAnalysis::visit(FunDefNode *node)
+{
+    escapes.assign(node->frame_size, false);
+    new_candidates.clear();
+    decl_candidates.clear();
+
+    node->body->accept(this);
+
+    for (auto &candidate : new_candidates)
+        candidate.second->frame_local = !escapes[candidate.first];
+    for (auto &candidate : decl_candidates)
+        candidate.second->frame_local = !escapes[candidate.first];
+}
+
+void EscapeAnalysis::visit(DataDefNode *node) {}
+void EscapeAnalysis::visit(TypeNode *node) {}
+
+// --- Comandos ---
+
+void EscapeAnalysis::visit(BlockCmdNode *node)
+{
+    for (Command *cmd : node->commands)
+        cmd->accept(this);
+}
+
+void EscapeAnalysis::visit(VarDeclNode *node)
+{
+    TypeNode *type = node->type;
+    if (node->slot >= 0 && type && !type->is_primitive && !type->is_array)
+        decl_candidates.emplace_back(node->slot, node);
+}
+
+void EscapeAnalysis::visit(AssignCmdNode *node)
+{
+    node->expr->accept(this);
+
+    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    {
+        auto *alloc = dynamic_cast<NewExprNode *>(node->expr);
+        if (alloc && va->slot >= 0)
+            new_candidates.emplace_back(va->slot, alloc);
+        return;
+    }
+    node->lvalue->accept(this); // x.campo = e / x[i] = e: só o valor de e escapa
+}
+
+void EscapeAnalysis::visit(ReadCmdNode *node)
+{
+    through(node->lvalue);
+}
+
+void EscapeAnalysis::visit(PrintCmd *node)
+{
+    through(node->expr);
+}
+
+void EscapeAnalysis::visit(ReturnCmdNode *node)
+{
+    for (Expression *expr : node->expressions)
+        expr->accept(this);
+}
+
+void EscapeAnalysis::visit(IfCmdNode *node)
+{
+    node->condition->accept(this);
+    node->then_branch->accept(this);
+    if (node->else_branch)
+        node->else_branch->accept(this);
+}
+
+void EscapeAnalysis::visit(IterateCmdNode *node)
+{
+    node->condition->accept(this);
+    node->body->accept(this);
+}
+
+void EscapeAnalysis::visit(FunCallCmdNode *node)
+{
+    for (Expression *arg : node->args)
+        arg->accept(this);
+    for (Expression *lval : node->lvalues)
+        through(lval);
+}
+
+// --- Expressões ---
+
+void EscapeAnalysis::visit(VarAccessNode *node)
+{
+    if (node->slot >= 0 && static_cast<size_t>(node->slot) < escapes.size())
+        escapes[node->slot] = true;
+}
+
+void EscapeAnalysis::visit(FunCallNode *node)
+{
+    for (Expression *arg : node->args)
+        arg->accept(this);
+    node->return_index->accept(this);
+}
+
+void EscapeAnalysis::visit(NewExprNode *node)
+{
+    for (Expression *dim : node->dims)
+    {
+        if (dim)
+            dim->accept(this);
+    }
+}
+
+void EscapeAnalysis::visit(FieldAccessNode *node)
+{
+    through(node->record_expr);
+}
+
+void EscapeAnalysis::visit(ArrayAccessNode *node)
+{
+    through(node->array_expr);
+    node->index_expr->accept(this);
+}
+
+void EscapeAnalysis::visit(UnaryOpNode *node)
+{
+    node->expr->accept(this);
+}
+
+void EscapeAnalysis::visit(BinaryOpNode *node)
+{
+    // Comparar referências não as guarda em lugar nenhum.
+    if (node->op == '=' || node->op == 'n')
+    {
+        through(node->left);
+        through(node->right);
+        return;
+    }
+    node->left->accept(this);
+    node->right->accept(this);
+}
+
+void EscapeAnalysis::visit(IntLiteral *node) {}
+void EscapeAnalysis::visit(FloatLiteralNode *node) {}
+void EscapeAnalysis::visit(CharLiteralNode *node) {}
+void EscapeAnalysis::visit(BoolLiteralNode *node) {}
+void EscapeAnalysis::visit(NullLiteralNode *node) {}
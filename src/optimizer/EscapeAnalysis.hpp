@@ -0,0 +1,61 @@
+#ifndef ESCAPE_ANALYSIS_HPP
+#define ESCAPE_ANALYSIS_HPP
+
+#include "../ast/Visitor.hpp"
+#include <utility>
+#include <vector>
+
+class Expression;
+
+// Análise de escape intraprocedural, executada após o Resolver (-O1).
+//
+// Uma variável local "escapa" quando o seu valor pode sair do frame: é
+// retornada, passada como argumento, atribuída a outra variável, a um campo
+// ou a um elemento, ou percorrida por um iterate. Usos que só leem através
+// dela (x.campo, x[i], x == y, print x) e atribuições a ela não contam.
+//
+// Alocações guardadas diretamente numa variável que não escapa
+// (`x = new T...;` e `x :: T;` de registro) são marcadas com frame_local e
+// vão para a região da chamada (Heap::to_region), liberada quando ela termina.
+class EscapeAnalysis : public Visitor
+{
+public:
+    void analyze(ProgramNode *ast);
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    std::vector<bool> escapes; // por slot da função atual
+    std::vector<std::pair<int, NewExprNode *>> new_candidates;
+    std::vector<std::pair<int, VarDeclNode *>> decl_candidates;
+
+    // Visita 'expr' num uso que não deixa o valor de uma variável sair
+    // do frame: uma variável simples ali não é marcada.
+    void through(Expression *expr);
+};
+
+#endif
@@ -0,0 +1,325 @@
+#include "Optimizer.hpp"
+#include "../ast/AST.hpp"
+#include "../runtime/Value.hpp"
+#include <climits>
+
+// --- Constantes ---
+
+// Valor de um literal primitivo; NIL para qualquer outra expressão.
+static Value constant_of(Expression *expr)
+{
+    if (auto *lit = dynamic_cast<IntLiteral *>(expr))
+        return Value::make_int(lit->value);
+    if (auto *lit = dynamic_cast<FloatLiteralNode *>(expr))
+        return Value::make_float(lit->value);
+    if (auto *lit = dynamic_cast<CharLiteralNode *>(expr))
+        return Value::make_char(lit->value);
+    if (auto *lit = dynamic_cast<BoolLiteralNode *>(expr))
+        return Value::make_bool(lit->value);
+    return Value();
+}
+
+static Expression *literal_of(const Value &v)
+{
+    switch (v.kind)
+    {
+    case ValueKind::INT:
+        return new IntLiteral(v.i);
+    case ValueKind::FLOAT:
+        return new FloatLiteralNode(v.f);
+    case ValueKind::CHAR:
+        return new CharLiteralNode(v.c);
+    case ValueKind::BOOL:
+        return new BoolLiteralNode(v.b);
+    default:
+        return nullptr;
+    }
+}
+
+// Int com estouro dá a volta (complemento de dois), como a aritmética da
+// execução faz na prática; feito em unsigned para não ser comportamento
+// indefinido aqui.
+static int wrap_int(unsigned v) { return static_cast<int>(v); }
+
+// Mesmas regras de Interpreter::visit(BinaryOpNode). Devolve NIL quando a
+// operação não é decidida aqui (inclusive quando falharia na execução:
+// divisão por zero e INT_MIN / -1 ficam para ela).
+static Value fold_binary(char op, const Value &l, const Value &r)
+{
+    if (op == '=' || op == 'n')
+    {
+        bool equal = l.equals(r);
+        return Value::make_bool(op == '=' ? equal : !equal);
+    }
+    if (l.is_int() && r.is_int())
+    {
+        switch (op)
+        {
+        case '+':
+            return Value::make_int(wrap_int(static_cast<unsigned>(l.i) + static_cast<unsigned>(r.i)));
+        case '-':
+            return Value::make_int(wrap_int(static_cast<unsigned>(l.i) - static_cast<unsigned>(r.i)));
+        case '*':
+            return Value::make_int(wrap_int(static_cast<unsigned>(l.i) * static_cast<unsigned>(r.i)));
+        case '/':
+        case '%':
+            if (r.i == 0 || (l.i == INT_MIN && r.i == -1))
+                return Value();
+            return Value::make_int(op == '/' ? l.i / r.i : l.i % r.i);
+        case '<':
+            return Value::make_bool(l.i < r.i);
+        case '>':
+            return Value::make_bool(l.i > r.i);
+        }
+        return Value();
+    }
+    if ((l.is_int() || l.is_float()) && (r.is_int() || r.is_float()))
+    {
+        float a = l.is_float() ? l.f : static_cast<float>(l.i);
+        float b = r.is_float() ? r.f : static_cast<float>(r.i);
+        switch (op)
+        {
+        case '+':
+            return Value::make_float(a + b);
+        case '-':
+            return Value::make_float(a - b);
+        case '*':
+            return Value::make_float(a * b);
+        case '/':
+            return Value::make_float(a / b);
+        case '<':
+            return Value::make_bool(a < b);
+        case '>':
+            return Value::make_bool(a > b);
+        }
+        return Value();
+    }
+    if (op == '&' && l.is_bool() && r.is_bool())
+        return Value::make_bool(l.b && r.b);
+    return Value();
+}
+
+static bool is_empty_block(Command *cmd)
+{
+    auto *block = dynamic_cast<BlockCmdNode *>(cmd);
+    return block && block->commands.empty();
+}
+
+// --- Reescrita ---
+
+Expression *Optimizer::fold(Expression *expr)
+{
+    if (!expr)
+        return nullptr;
+    expr_result = nullptr;
+    expr->accept(this);
+    Expression *result = expr_result ? expr_result : expr;
+    expr_result = nullptr;
+    if (result != expr)
+    {
+        if (result->loc.line == 0)
+            result->loc = expr->loc; // nós criados aqui herdam a posição do original
+        delete expr;
+        ++rewrite_count;
+    }
+    return result;
+}
+
+Command *Optimizer::simplify(Command *cmd)
+{
+    if (!cmd)
+        return nullptr;
+    cmd_result = nullptr;
+    cmd->accept(this);
+    Command *result = cmd_result ? cmd_result : cmd;
+    cmd_result = nullptr;
+    if (result != cmd)
+    {
+        if (result->loc.line == 0)
+            result->loc = cmd->loc;
+        delete cmd;
+        ++rewrite_count;
+    }
+    return result;
+}
+
+void Optimizer::optimize(ProgramNode *ast)
+{
+    if (ast)
+        ast->accept(this);
+}
+
+void Optimizer::visit(ProgramNode *node)
+{
+    for (Node *def : node->definitions)
+        def->accept(this);
+}
+
+void Optimizer::visit(FunDefNode *node)
+{
+    node->body->accept(this);
+}
+
+void Optimizer::visit(DataDefNode *node) {}
+void Optimizer::visit(TypeNode *node) {}
+void Optimizer::visit(VarDeclNode *node) {}
+
+// --- Comandos ---
+
+void Optimizer::visit(BlockCmdNode *node)
+{
+    std::vector<Command *> kept;
+    kept.reserve(node->commands.size());
+    bool unreachable = false;
+    for (Command *cmd : node->commands)
+    {
+        if (unreachable)
+        {
+            // Depois de um return o bloco nunca continua.
+            delete cmd;
+            ++rewrite_count;
+            continue;
+        }
+        cmd = simplify(cmd);
+        if (is_empty_block(cmd))
+        {
+            delete cmd;
+            ++rewrite_count;
+            continue;
+        }
+        unreachable = dynamic_cast<ReturnCmdNode *>(cmd) != nullptr;
+        kept.push_back(cmd);
+    }
+    node->commands.swap(kept);
+}
+
+void Optimizer::visit(IfCmdNode *node)
+{
+    node->condition = fold(node->condition);
+    node->then_branch = simplify(node->then_branch);
+    node->else_branch = simplify(node->else_branch);
+
+    auto *lit = dynamic_cast<BoolLiteralNode *>(node->condition);
+    if (!lit)
+        return;
+    // O ramo escolhido assume o lugar do if; os ramos não criam escopo
+    // próprio (só blocos o fazem), então a resolução de nomes não muda.
+    Command *&taken = lit->value ? node->then_branch : node->else_branch;
+    cmd_result = taken ? taken : new BlockCmdNode(nullptr);
+    taken = nullptr;
+}
+
+void Optimizer::visit(IterateCmdNode *node)
+{
+    // A contagem já é avaliada uma única vez na entrada do laço (tanto no
+    // interpretador quanto na VM); aqui ela só é dobrada.
+    node->condition = fold(node->condition);
+    node->body = simplify(node->body);
+
+    auto *count = dynamic_cast<IntLiteral *>(node->condition);
+    // Com contagem literal, um laço que nunca executa (ou cujo corpo ficou
+    // vazio) não tem efeito observável.
+    if (count && (count->value <= 0 || is_empty_block(node->body)))
+        cmd_result = new BlockCmdNode(nullptr);
+}
+
+void Optimizer::visit(AssignCmdNode *node)
+{
+    node->lvalue = fold(node->lvalue);
+    node->expr = fold(node->expr);
+}
+
+void Optimizer::visit(PrintCmd *node)
+{
+    node->expr = fold(node->expr);
+}
+
+void Optimizer::visit(ReadCmdNode *node)
+{
+    node->lvalue = fold(node->lvalue);
+}
+
+void Optimizer::visit(ReturnCmdNode *node)
+{
+    for (Expression *&expr : node->expressions)
+        expr = fold(expr);
+}
+
+void Optimizer::visit(FunCallCmdNode *node)
+{
+    for (Expression *&arg : node->args)
+        arg = fold(arg);
+    for (Expression *&lval : node->lvalues)
+        lval = fold(lval);
+}
+
+// --- Expressões ---
+
+void Optimizer::visit(FunCallNode *node)
+{
+    for (Expression *&arg : node->args)
+        arg = fold(arg);
+    node->return_index = fold(node->return_index);
+}
+
+void Optimizer::visit(NewExprNode *node)
+{
+    for (Expression *&dim : node->dims)
+        dim = fold(dim);
+}
+
+void Optimizer::visit(FieldAccessNode *node)
+{
+    node->record_expr = fold(node->record_expr);
+}
+
+void Optimizer::visit(ArrayAccessNode *node)
+{
+    node->array_expr = fold(node->array_expr);
+    node->index_expr = fold(node->index_expr);
+}
+
+void Optimizer::visit(UnaryOpNode *node)
+{
+    node->expr = fold(node->expr);
+    Value v = constant_of(node->expr);
+    if (node->op == '-' && v.is_int())
+        expr_result = new IntLiteral(wrap_int(0u - static_cast<unsigned>(v.i)));
+    else if (node->op == '-' && v.is_float())
+        expr_result = new FloatLiteralNode(-v.f);
+    else if (node->op == '!' && v.is_bool())
+        expr_result = new BoolLiteralNode(!v.b);
+}
+
+void Optimizer::visit(BinaryOpNode *node)
+{
+    node->left = fold(node->left);
+    node->right = fold(node->right);
+
+    Value l = constant_of(node->left);
+    Value r = constant_of(node->right);
+    if (!l.is_nil() && !r.is_nil())
+    {
+        expr_result = literal_of(fold_binary(node->op, l, r));
+        return;
+    }
+
+    // `true && e` e `e && true` valem e; o outro lado é sempre avaliado, então
+    // não há curto-circuito a preservar. Só com tipos provados (BOOL_AND).
+    if (node->spec == BinarySpec::BOOL_AND)
+    {
+        Expression *&other = (l.is_bool() && l.b) ? node->right : node->left;
+        if ((l.is_bool() && l.b) || (r.is_bool() && r.b))
+        {
+            expr_result = other;
+            other = nullptr;
+        }
+    }
+}
+
+void Optimizer::visit(IntLiteral *node) {}
+void Optimizer::visit(FloatLiteralNode *node) {}
+void Optimizer::visit(CharLiteralNode *node) {}
+void Optimizer::visit(BoolLiteralNode *node) {}
+void Optimizer::visit(VarAccessNode *node) {}
+void Optimizer::visit(NullLiteralNode *node) {}
@@ -0,0 +1,67 @@
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include "../ast/Visitor.hpp"
+#include <cstddef>
+
+class Expression;
+class Command;
+
+// Passo opcional (-O1) executado entre o TypeChecker e o Resolver. Reescreve
+// a AST no lugar:
+//  - dobra operações binárias e unárias cujos operandos são literais,
+//    reproduzindo exatamente a aritmética do interpretador (divisão inteira
+//    por zero não é dobrada, para falhar em tempo de execução como antes);
+//  - troca `if` com condição literal pelo ramo escolhido;
+//  - dobra a contagem do `iterate` e remove laços que nunca executam;
+//  - descarta comandos que seguem um `return` no mesmo bloco.
+//
+// Os nós substituídos são liberados aqui; a AST resultante continua válida
+// para o Resolver, o interpretador e o compilador da VM.
+class Optimizer : public Visitor
+{
+public:
+    void optimize(ProgramNode *ast);
+
+    // Número de nós substituídos ou removidos (útil para --dump-ast).
+    std::size_t rewrites() const { return rewrite_count; }
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    // Substituto do nó visitado; nullptr mantém o próprio nó.
+    Expression *expr_result = nullptr;
+    Command *cmd_result = nullptr;
+    std::size_t rewrite_count = 0;
+
+    // Visitam o nó e devolvem o que deve ocupar o lugar dele na árvore,
+    // liberando o original quando ele foi substituído.
+    Expression *fold(Expression *expr);
+    Command *simplify(Command *cmd);
+};
+
+#endif
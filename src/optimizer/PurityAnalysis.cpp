@@ -0,0 +1,163 @@
+#include "PurityAnalysis.hpp"
+#include "../ast/AST.hpp"
+
+void PurityAnalysis::analyze(ProgramNode *ast)
+{
+    if (ast)
+        ast->accept(this);
+}
+
+void PurityAnalysis::call(FunDefNode *target)
+{
+    // Sem definição conhecida a chamada não executa nada.
+    if (current && target)
+        callees[current].push_back(target);
+}
+
+void PurityAnalysis::visit(ProgramNode *node)
+{
+    std::vector<FunDefNode *> functions;
+    for (Node *def : node->definitions)
+    {
+        if (auto *fun = dynamic_cast<FunDefNode *>(def))
+        {
+            fun->pure = true;
+            functions.push_back(fun);
+            fun->accept(this); // pode rebaixar fun->pure
+        }
+    }
+
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (FunDefNode *fun : functions)
+        {
+            if (!fun->pure)
+                continue;
+            for (FunDefNode *target : callees[fun])
+            {
+                if (!target->pure)
+                {
+                    fun->pure = false;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (FunDefNode *fun : functions)
+    {
+        bool primitive = fun->pure && !fun->return_types.empty();
+        for (const FunDefNode::Param &param : fun->params)
+            primitive = primitive && param.type->is_primitive && !param.type->is_array;
+        for (TypeNode *ret : fun->return_types)
+            primitive = primitive && ret->is_primitive && !ret->is_array;
+        fun->memoizable = primitive;
+    }
+}
+
+void PurityAnalysis::visit(FunDefNode *node)
+{
+    current = node;
+    node->body->accept(this);
+    current = nullptr;
+}
+
+void PurityAnalysis::visit(DataDefNode *node) {}
+void PurityAnalysis::visit(TypeNode *node) {}
+void PurityAnalysis::visit(VarDeclNode *node) {}
+
+// --- Comandos ---
+
+void PurityAnalysis::visit(BlockCmdNode *node)
+{
+    for (Command *cmd : node->commands)
+        cmd->accept(this);
+}
+
+void PurityAnalysis::visit(AssignCmdNode *node)
+{
+    if (node->target != AssignCmdNode::Target::VARIABLE)
+        current->pure = false; // altera um registro ou array
+    node->lvalue->accept(this);
+    node->expr->accept(this);
+}
+
+void PurityAnalysis::visit(PrintCmd *node) { current->pure = false; }
+void PurityAnalysis::visit(ReadCmdNode *node) { current->pure = false; }
+
+void PurityAnalysis::visit(ReturnCmdNode *node)
+{
+    for (Expression *expr : node->expressions)
+        expr->accept(this);
+}
+
+void PurityAnalysis::visit(IfCmdNode *node)
+{
+    node->condition->accept(this);
+    node->then_branch->accept(this);
+    if (node->else_branch)
+        node->else_branch->accept(this);
+}
+
+void PurityAnalysis::visit(IterateCmdNode *node)
+{
+    node->condition->accept(this);
+    node->body->accept(this);
+}
+
+void PurityAnalysis::visit(FunCallCmdNode *node)
+{
+    call(node->target);
+    for (Expression *arg : node->args)
+        arg->accept(this);
+}
+
+// --- Expressões ---
+
+void PurityAnalysis::visit(FunCallNode *node)
+{
+    call(node->target);
+    for (Expression *arg : node->args)
+        arg->accept(this);
+    node->return_index->accept(this);
+}
+
+void PurityAnalysis::visit(NewExprNode *node)
+{
+    for (Expression *dim : node->dims)
+    {
+        if (dim)
+            dim->accept(this);
+    }
+}
+
+void PurityAnalysis::visit(FieldAccessNode *node)
+{
+    node->record_expr->accept(this);
+}
+
+void PurityAnalysis::visit(ArrayAccessNode *node)
+{
+    node->array_expr->accept(this);
+    node->index_expr->accept(this);
+}
+
+void PurityAnalysis::visit(UnaryOpNode *node)
+{
+    node->expr->accept(this);
+}
+
+void PurityAnalysis::visit(BinaryOpNode *node)
+{
+    node->left->accept(this);
+    node->right->accept(this);
+}
+
+void PurityAnalysis::visit(IntLiteral *node) {}
+void PurityAnalysis::visit(FloatLiteralNode *node) {}
+void PurityAnalysis::visit(CharLiteralNode *node) {}
+void PurityAnalysis::visit(BoolLiteralNode *node) {}
+void PurityAnalysis::visit(VarAccessNode *node) {}
+void PurityAnalysis::visit(NullLiteralNode *node) {}
@@ -0,0 +1,57 @@
+#ifndef PURITY_ANALYSIS_HPP
+#define PURITY_ANALYSIS_HPP
+
+#include "../ast/Visitor.hpp"
+#include <unordered_map>
+#include <vector>
+
+// Classifica as funções puras (FunDefNode::pure), executada após o
+// TypeChecker, que já ligou cada chamada à sua definição.
+//
+// Uma função é pura quando não faz `print` nem `read`, não atribui a campos
+// de registro nem a elementos de array e só chama funções puras. Com
+// recursão (inclusive mútua), todas começam puras e as que chamam uma
+// impura são rebaixadas até nada mudar.
+//
+// Com parâmetros e retornos primitivos, o resultado de uma função pura só
+// depende dos argumentos: é o que --memoize usa (FunDefNode::memoizable).
+class PurityAnalysis : public Visitor
+{
+public:
+    void analyze(ProgramNode *ast);
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    // Funções chamadas por cada função (com repetições).
+    std::unordered_map<FunDefNode *, std::vector<FunDefNode *>> callees;
+    FunDefNode *current = nullptr;
+
+    void call(FunDefNode *target);
+};
+
+#endif
@@ -2,6 +2,9 @@
     #include <vector>
     #include <string>
     #include "ast/AST.hpp"
+    #include "ast/Symbol.hpp"
+    #include "ast/SourceLoc.hpp"
+    class Lexer;
 }
 
 %{
@@ -17,21 +20,46 @@
 #include "ast/NewExprNode.hpp"
 #include "ast/FieldAccessNode.hpp"
 #include "ast/ArrayAccessNode.hpp"
+#include "lexer/Lexer.hpp"
 
-extern int yylex();
-extern int yylineno;
-void yyerror(const char* s);
-bool parse_error_detected = false;
-
-ProgramNode* ast_root = nullptr;
+// A posição de uma regra é a do seu primeiro símbolo (se vazia, a do
+// símbolo anterior).
+#define YYLLOC_DEFAULT(Current, Rhs, N) \
+    ((Current) = (N) ? YYRHSLOC(Rhs, 1) : YYRHSLOC(Rhs, 0))
 %}
 
+%code {
+static int yylex(YYSTYPE* value, YYLTYPE* loc, Lexer& lexer)
+{
+    int kind = lexer.next(*value);
+    *loc = lexer.location();
+    return kind;
+}
+
+// Cada nó guarda a posição do seu primeiro token.
+template <class T>
+static T* at(T* node, const SourceLoc& loc)
+{
+    node->loc = loc;
+    return node;
+}
+void yyerror(YYLTYPE* loc, Lexer& lexer, ProgramNode*& ast_root, const char* s);
+}
+
+/* Parser reentrante: o estado léxico vem no Lexer e o resultado volta em ast_root. */
+%define api.pure full
+%locations
+/* Posição compacta (arquivo, linha, coluna do primeiro token): é o que os nós guardam. */
+%define api.location.type {SourceLoc}
+%lex-param   { Lexer& lexer }
+%parse-param { Lexer& lexer } { ProgramNode*& ast_root }
+
 %union {
     int                 ival;
     float               fval;
     char                cval;
     bool                bval;
-    char* sval;
+    Symbol              sym;
     ProgramNode* program_node;
     Command* command_node;
     Expression* expression_node;
@@ -55,7 +83,7 @@ ProgramNode* ast_root = nullptr;
 %token <ival> T_INT_LITERAL
 %token <fval> T_FLOAT_LITERAL
 %token <cval> T_CHAR_LITERAL
-%token <sval> T_ID T_TYID
+%token <sym> T_ID T_TYID
 %token <bval> T_TRUE T_FALSE
 %token T_NULL "null"
 %token T_PRINT "print"
@@ -108,7 +136,7 @@ ProgramNode* ast_root = nullptr;
 %% /* ===================  GRAMMAR  =================== */
 
 program:
-    def_list                      { ast_root = new ProgramNode($1); }
+    def_list                      { ast_root = at(new ProgramNode($1), @$); }
     ;
 
 def_list:
@@ -123,11 +151,11 @@ def:
 
 fun_def:
     T_ID '(' params ')' optional_return_types block
-                                  { $$ = new FunDefNode($1, $3, $5, dynamic_cast<BlockCmdNode*>($6)); }
+                                  { $$ = at(new FunDefNode($1, $3, $5, dynamic_cast<BlockCmdNode*>($6)), @$); }
     ;
 
 data_def:
-    T_DATA T_TYID '{' field_list '}'  { $$ = new DataDefNode($2, $4); }
+    T_DATA T_TYID '{' field_list '}'  { $$ = at(new DataDefNode($2, $4), @$); }
     ;
 
 field_list:
@@ -136,7 +164,7 @@ field_list:
     ;
 
 field_decl:
-    T_ID T_COLON_COLON type ';'  { $$ = new VarDeclNode($1, $3); }
+    T_ID T_COLON_COLON type ';'  { $$ = at(new VarDeclNode($1, $3), @$); }
     ;
 
 params:
@@ -150,7 +178,7 @@ param_list_non_empty:
     ;
 
 param:
-    T_ID T_COLON_COLON type      { $$ = new FunDefNode::Param({std::string($1), $3}); free($1); }
+    T_ID T_COLON_COLON type      { $$ = new FunDefNode::Param({$1, $3}); }
     ;
 
 optional_return_types:
@@ -176,15 +204,15 @@ command:
     | block
     | read_cmd
     | return_cmd
-    | T_PRINT expression ';'     { $$ = new PrintCmd($2); }
+    | T_PRINT expression ';'     { $$ = at(new PrintCmd($2), @$); }
     | fun_call_cmd ';'           { $$ = $1; }
     ;
 
 fun_call_cmd:
     T_ID '(' optional_expression_list ')'
-      { $$ = new FunCallCmdNode($1, $3, nullptr); }
+      { $$ = at(new FunCallCmdNode($1, $3, nullptr), @$); }
   | T_ID '(' optional_expression_list ')' LT_CAPTURE lvalue_list '>'
-      { $$ = new FunCallCmdNode($1, $3, $6); }
+      { $$ = at(new FunCallCmdNode($1, $3, $6), @$); }
   ;
 
 lvalue_list:
@@ -193,15 +221,15 @@ lvalue_list:
     ;
 
 block:
-    '{' command_list '}'         { $$ = new BlockCmdNode($2); }
+    '{' command_list '}'         { $$ = at(new BlockCmdNode($2), @$); }
     ;
 
 read_cmd:
-    T_READ lvalue ';'            { $$ = new ReadCmdNode($2); }
+    T_READ lvalue ';'            { $$ = at(new ReadCmdNode($2), @$); }
     ;
 
 return_cmd:
-    T_RETURN expression_list ';' { $$ = new ReturnCmdNode($2); }
+    T_RETURN expression_list ';' { $$ = at(new ReturnCmdNode($2), @$); }
     ;
 
 expression_list:
@@ -218,89 +246,89 @@ optional_expression_list:
 
 if_cmd:
     T_IF '(' expression ')' command %prec T_IF
-        { $$ = new IfCmdNode($3, $5, nullptr); }
+        { $$ = at(new IfCmdNode($3, $5, nullptr), @$); }
   | T_IF '(' expression ')' command T_ELSE command
-        { $$ = new IfCmdNode($3, $5, $7); }
+        { $$ = at(new IfCmdNode($3, $5, $7), @$); }
   ;
 
 iterate_cmd:
     T_ITERATE '(' expression ')' command
-        { $$ = new IterateCmdNode(nullptr, $3, $5); }
+        { $$ = at(new IterateCmdNode(Symbol{}, $3, $5), @$); }
   | T_ITERATE '(' T_ID ':' expression ')' command
-        { $$ = new IterateCmdNode($3, $5, $7); }
+        { $$ = at(new IterateCmdNode($3, $5, $7), @$); }
   ;
 
 var_decl:
-    T_ID T_COLON_COLON type ';'  { $$ = new VarDeclNode($1, $3); }
+    T_ID T_COLON_COLON type ';'  { $$ = at(new VarDeclNode($1, $3), @$); }
     ;
 
 assign_cmd:
-    lvalue '=' expression ';' { $$ = new AssignCmdNode($1, $3); }
+    lvalue '=' expression ';' { $$ = at(new AssignCmdNode($1, $3), @$); }
     ;
 
 lvalue:
       T_ID
-        { $$ = new VarAccessNode($1); }
+        { $$ = at(new VarAccessNode($1), @$); }
     | postfix_expression '.' T_ID
-        { $$ = new FieldAccessNode($1, $3); }
+        { $$ = at(new FieldAccessNode($1, $3), @$); }
     | postfix_expression '[' expression ']'
-        { $$ = new ArrayAccessNode($1, $3); }
+        { $$ = at(new ArrayAccessNode($1, $3), @$); }
     ;
 
 type:
       atomic_type
-    | type '[' ']'               { $$ = new TypeNode($1); }
+    | type '[' ']'               { $$ = at(new TypeNode($1), @$); }
     ;
 
 atomic_type:
-      T_TYPE_INT                 { $$ = new TypeNode(Primitive::INT); }
-    | T_TYPE_BOOL                { $$ = new TypeNode(Primitive::BOOL); }
-    | T_TYPE_CHAR                { $$ = new TypeNode(Primitive::CHAR); }
-    | T_TYPE_FLOAT               { $$ = new TypeNode(Primitive::FLOAT); }
-    | T_TYPE_VOID                { $$ = new TypeNode(Primitive::VOID); }
-    | T_TYID                     { $$ = new TypeNode($1); }
+      T_TYPE_INT                 { $$ = at(new TypeNode(Primitive::INT), @$); }
+    | T_TYPE_BOOL                { $$ = at(new TypeNode(Primitive::BOOL), @$); }
+    | T_TYPE_CHAR                { $$ = at(new TypeNode(Primitive::CHAR), @$); }
+    | T_TYPE_FLOAT               { $$ = at(new TypeNode(Primitive::FLOAT), @$); }
+    | T_TYPE_VOID                { $$ = at(new TypeNode(Primitive::VOID), @$); }
+    | T_TYID                     { $$ = at(new TypeNode($1), @$); }
     ;
 
 expression:
       postfix_expression
-    | '!' expression             { $$ = new UnaryOpNode('!', $2); }
-    | '-' expression %prec UMINUS{ $$ = new UnaryOpNode('-', $2); }
-    | expression T_AND expression{ $$ = new BinaryOpNode($1, '&', $3); }
-    | expression T_EQ  expression{ $$ = new BinaryOpNode($1, '=', $3); }
-    | expression T_NEQ expression{ $$ = new BinaryOpNode($1, 'n', $3); }
-    | expression '<' expression  { $$ = new BinaryOpNode($1, '<', $3); }
-    | expression '>' expression  { $$ = new BinaryOpNode($1, '>', $3); }
-    | expression '+' expression  { $$ = new BinaryOpNode($1, '+', $3); }
-    | expression '-' expression  { $$ = new BinaryOpNode($1, '-', $3); }
-    | expression '*' expression  { $$ = new BinaryOpNode($1, '*', $3); }
-    | expression '/' expression  { $$ = new BinaryOpNode($1, '/', $3); }
-    | expression '%' expression  { $$ = new BinaryOpNode($1, '%', $3); }
+    | '!' expression             { $$ = at(new UnaryOpNode('!', $2), @$); }
+    | '-' expression %prec UMINUS{ $$ = at(new UnaryOpNode('-', $2), @$); }
+    | expression T_AND expression{ $$ = at(new BinaryOpNode($1, '&', $3), @$); }
+    | expression T_EQ  expression{ $$ = at(new BinaryOpNode($1, '=', $3), @$); }
+    | expression T_NEQ expression{ $$ = at(new BinaryOpNode($1, 'n', $3), @$); }
+    | expression '<' expression  { $$ = at(new BinaryOpNode($1, '<', $3), @$); }
+    | expression '>' expression  { $$ = at(new BinaryOpNode($1, '>', $3), @$); }
+    | expression '+' expression  { $$ = at(new BinaryOpNode($1, '+', $3), @$); }
+    | expression '-' expression  { $$ = at(new BinaryOpNode($1, '-', $3), @$); }
+    | expression '*' expression  { $$ = at(new BinaryOpNode($1, '*', $3), @$); }
+    | expression '/' expression  { $$ = at(new BinaryOpNode($1, '/', $3), @$); }
+    | expression '%' expression  { $$ = at(new BinaryOpNode($1, '%', $3), @$); }
     ;
 
 postfix_expression:
       primary_expression
-    | postfix_expression '[' expression ']' { $$ = new ArrayAccessNode($1, $3); }
-    | postfix_expression '.' T_ID           { $$ = new FieldAccessNode($1, $3); }
-    | T_ID '(' optional_expression_list ')' '[' expression ']' { $$ = new FunCallNode(std::string($1), $3, $6); free($1); }
+    | postfix_expression '[' expression ']' { $$ = at(new ArrayAccessNode($1, $3), @$); }
+    | postfix_expression '.' T_ID           { $$ = at(new FieldAccessNode($1, $3), @$); }
+    | T_ID '(' optional_expression_list ')' '[' expression ']' { $$ = at(new FunCallNode($1, $3, $6), @$); }
     ;
 
 primary_expression:
       lvalue
-    | T_INT_LITERAL                        { $$ = new IntLiteral($1); }
-    | T_FLOAT_LITERAL                      { $$ = new FloatLiteralNode($1); }
-    | T_CHAR_LITERAL                       { $$ = new CharLiteralNode($1); }
-    | T_TRUE                               { $$ = new BoolLiteralNode(true); }
-    | T_FALSE                              { $$ = new BoolLiteralNode(false); }
-    | T_NULL                               { $$ = new NullLiteralNode(); }
+    | T_INT_LITERAL                        { $$ = at(new IntLiteral($1), @$); }
+    | T_FLOAT_LITERAL                      { $$ = at(new FloatLiteralNode($1), @$); }
+    | T_CHAR_LITERAL                       { $$ = at(new CharLiteralNode($1), @$); }
+    | T_TRUE                               { $$ = at(new BoolLiteralNode(true), @$); }
+    | T_FALSE                              { $$ = at(new BoolLiteralNode(false), @$); }
+    | T_NULL                               { $$ = at(new NullLiteralNode(), @$); }
     | '(' expression ')'                   { $$ = $2; }
     | new_expression                       { $$ = $1; }
     ;
 
 new_expression:
       T_NEW atomic_type
-        { $$ = new NewExprNode($2, new std::vector<Expression*>()); }
+        { $$ = at(new NewExprNode($2, new std::vector<Expression*>()), @$); }
     | T_NEW atomic_type dim_list
-        { $$ = new NewExprNode($2, $3); }
+        { $$ = at(new NewExprNode($2, $3), @$); }
     ;
 
 dim_list:
@@ -317,11 +345,7 @@ optional_expression:
 
 %% /* =================== C-code =================== */
 
-void yyerror(const char* s)
+void yyerror(YYLTYPE* loc, Lexer& lexer, ProgramNode*& ast_root, const char* s)
 {
-    parse_error_detected = true;
-    extern char* yytext;
-    std::fprintf(stderr,
-                 "Erro sintático na linha %d: %s perto do texto '%s'\n",
-                 yylineno, s, yytext);
-}
\ No newline at end of file
+    lexer.error(s);
+}
@@ -1,12 +1,136 @@
 #ifndef ARRAY_VALUE_HPP
 #define ARRAY_VALUE_HPP
-#include "Value.hpp"
+#include "Heap.hpp"
+#include "../typecheck/Primitive.hpp"
+#include <cstdint>
 #include <vector>
 
-class ArrayValue : public Value
+// Arrays de Int, Float, Char e Bool guardam os elementos compactados
+// (4 ou 1 byte cada, começando em zero) em vez de um Value de 16 bytes;
+// os demais (registros, arrays de arrays) guardam Values, começando null.
+// elem_kind diz qual dos vetores está em uso: NIL para o genérico.
+class ArrayValue : public HeapObject
 {
 public:
-    std::vector<Value *> elements;
-    void print() const override { std::cout << "array@" << (void *)this; }
+    const ValueKind elem_kind;
+    std::vector<Value> elements; // elem_kind == NIL
+    std::vector<int32_t> ints;   // INT
+    std::vector<float> floats;   // FLOAT
+    std::vector<char> bytes;     // CHAR e BOOL
+
+    ArrayValue() : HeapObject(ValueKind::ARRAY), elem_kind(ValueKind::NIL) {}
+    explicit ArrayValue(std::size_t size, ValueKind elem = ValueKind::NIL)
+        : HeapObject(ValueKind::ARRAY), elem_kind(elem)
+    {
+        switch (elem)
+        {
+        case ValueKind::INT:
+            ints.resize(size);
+            break;
+        case ValueKind::FLOAT:
+            floats.resize(size);
+            break;
+        case ValueKind::CHAR:
+        case ValueKind::BOOL:
+            bytes.resize(size);
+            break;
+        default:
+            elements.resize(size);
+            break;
+        }
+    }
+
+    std::size_t size() const
+    {
+        switch (elem_kind)
+        {
+        case ValueKind::INT:
+            return ints.size();
+        case ValueKind::FLOAT:
+            return floats.size();
+        case ValueKind::CHAR:
+        case ValueKind::BOOL:
+            return bytes.size();
+        default:
+            return elements.size();
+        }
+    }
+
+    // Acesso sem verificação de limites (quem chama já verificou).
+    Value get(std::size_t i) const
+    {
+        switch (elem_kind)
+        {
+        case ValueKind::INT:
+            return Value::make_int(ints[i]);
+        case ValueKind::FLOAT:
+            return Value::make_float(floats[i]);
+        case ValueKind::CHAR:
+            return Value::make_char(bytes[i]);
+        case ValueKind::BOOL:
+            return Value::make_bool(bytes[i] != 0);
+        default:
+            return elements[i];
+        }
+    }
+
+    // O TypeChecker garante o tipo do valor; null grava zero.
+    void set(std::size_t i, const Value &v)
+    {
+        switch (elem_kind)
+        {
+        case ValueKind::INT:
+            ints[i] = v.i;
+            break;
+        case ValueKind::FLOAT:
+            floats[i] = v.is_int() ? static_cast<float>(v.i) : v.f;
+            break;
+        case ValueKind::CHAR:
+            bytes[i] = v.c;
+            break;
+        case ValueKind::BOOL:
+            bytes[i] = v.b;
+            break;
+        default:
+            elements[i] = v;
+            break;
+        }
+    }
+
+    void print(Output &out) const override
+    {
+        out.write("array@");
+        out.write_pointer(this);
+    }
+    void trace(Heap &heap) const override
+    {
+        for (const Value &v : elements)
+            heap.mark(v);
+    }
+    std::size_t size_bytes() const override
+    {
+        return sizeof(ArrayValue) + elements.capacity() * sizeof(Value) + ints.capacity() * sizeof(int32_t) +
+               floats.capacity() * sizeof(float) + bytes.capacity();
+    }
 };
-#endif
\ No newline at end of file
+
+inline ArrayValue *Value::as_array() const { return static_cast<ArrayValue *>(ref); }
+
+// Tipo dos elementos compactados para um array de 'prim'; NIL se não há.
+inline ValueKind packed_kind(Primitive prim)
+{
+    switch (prim)
+    {
+    case Primitive::INT:
+        return ValueKind::INT;
+    case Primitive::FLOAT:
+        return ValueKind::FLOAT;
+    case Primitive::CHAR:
+        return ValueKind::CHAR;
+    case Primitive::BOOL:
+        return ValueKind::BOOL;
+    default:
+        return ValueKind::NIL;
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+#ifndef BINARY_IO_HPP
+#define BINARY_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Codificação dos arquivos binários do lang (cache de bytecode, AST
+// serializada): números na ordem de bytes nativa, textos com o tamanho na
+// frente e soma FNV-1a do conteúdo.
+
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+// FNV-1a de 64 bits.
+inline std::uint64_t fnv1a(std::uint64_t hash, const void *data, std::size_t size)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Gravação: tudo vai para um buffer e é escrito de uma vez.
+class BinaryWriter
+{
+public:
+    void u32(std::uint32_t v) { raw(&v, sizeof v); }
+    void i32(std::int32_t v) { raw(&v, sizeof v); }
+    void u64(std::uint64_t v) { raw(&v, sizeof v); }
+    void str(const std::string &s)
+    {
+        u32(static_cast<std::uint32_t>(s.size()));
+        raw(s.data(), s.size());
+    }
+    void raw(const void *data, std::size_t size) { bytes.append(static_cast<const char *>(data), size); }
+    const std::string &data() const { return bytes; }
+
+private:
+    std::string bytes;
+};
+
+// Leitura com verificação de limites: um arquivo truncado ou corrompido
+// só faz 'ok' ficar falso.
+class BinaryReader
+{
+public:
+    BinaryReader(const char *begin, const char *end) : pos(begin), end(end) {}
+    bool ok = true;
+
+    std::uint32_t u32() { return scalar<std::uint32_t>(); }
+    std::int32_t i32() { return scalar<std::int32_t>(); }
+    std::uint64_t u64() { return scalar<std::uint64_t>(); }
+    // O texto aponta para o buffer lido, sem cópia.
+    std::string_view view()
+    {
+        std::uint32_t size = u32();
+        if (!take(size))
+            return std::string_view();
+        return std::string_view(pos - size, size);
+    }
+    std::string str() { return std::string(view()); }
+    // Quantidade de itens de 'item_size' bytes que ainda cabem no arquivo.
+    std::uint32_t count(std::size_t item_size)
+    {
+        std::uint32_t n = u32();
+        if (ok && static_cast<std::size_t>(end - pos) / item_size < n)
+            ok = false;
+        return ok ? n : 0;
+    }
+    bool raw(void *out, std::size_t size)
+    {
+        if (!take(size))
+            return false;
+        std::memcpy(out, pos - size, size);
+        return true;
+    }
+    // Avança 'size' bytes e devolve o início deles (nullptr se não cabem).
+    const char *skip(std::size_t size) { return take(size) ? pos - size : nullptr; }
+    bool at_end() const { return pos == end; }
+
+private:
+    const char *pos;
+    const char *end;
+
+    bool take(std::size_t size)
+    {
+        if (!ok || static_cast<std::size_t>(end - pos) < size)
+            return ok = false;
+        pos += size;
+        return true;
+    }
+    template <typename T>
+    T scalar()
+    {
+        T v{};
+        raw(&v, sizeof v);
+        return v;
+    }
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "Heap.hpp"
+#include "ArrayValue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+
+Heap::Heap(std::size_t threshold)
+    : base_threshold(threshold), next_collection(threshold)
+{
+}
+
+Heap::~Heap()
+{
+    for (HeapObject *obj : objects)
+    {
+        delete obj;
+    }
+    for (HeapObject *obj : region_objects)
+    {
+        delete obj;
+    }
+}
+
+const char *heap_category_name(HeapCategory category)
+{
+    switch (category)
+    {
+    case HeapCategory::RECORD:
+        return "record";
+    case HeapCategory::ARRAY:
+        return "array";
+    case HeapCategory::ARRAY_INT:
+        return "array_int";
+    case HeapCategory::ARRAY_FLOAT:
+        return "array_float";
+    case HeapCategory::ARRAY_CHAR:
+        return "array_char";
+    case HeapCategory::ARRAY_BOOL:
+        return "array_bool";
+    default:
+        return "?";
+    }
+}
+
+static HeapCategory category_of(const HeapObject *obj)
+{
+    if (obj->kind == ValueKind::RECORD)
+        return HeapCategory::RECORD;
+    switch (static_cast<const ArrayValue *>(obj)->elem_kind)
+    {
+    case ValueKind::INT:
+        return HeapCategory::ARRAY_INT;
+    case ValueKind::FLOAT:
+        return HeapCategory::ARRAY_FLOAT;
+    case ValueKind::CHAR:
+        return HeapCategory::ARRAY_CHAR;
+    case ValueKind::BOOL:
+        return HeapCategory::ARRAY_BOOL;
+    default:
+        return HeapCategory::ARRAY;
+    }
+}
+
+void Heap::track(HeapObject *obj)
+{
+    std::size_t bytes = obj->size_bytes();
+    objects.push_back(obj);
+    live_bytes += bytes;
+    gc_stats.objects_allocated++;
+    gc_stats.bytes_allocated += bytes;
+    gc_stats.peak_live_bytes = std::max(gc_stats.peak_live_bytes, live_bytes);
+    gc_stats.peak_live_objects = std::max(gc_stats.peak_live_objects, live_object_count());
+    AllocCount &count = gc_stats.allocated_by[static_cast<std::size_t>(category_of(obj))];
+    count.objects++;
+    count.bytes += bytes;
+}
+
+void Heap::to_region(HeapObject *obj)
+{
+    if (region_starts.empty() || objects.empty() || objects.back() != obj)
+        return;
+    objects.pop_back();
+    region_objects.push_back(obj);
+}
+
+void Heap::pop_region()
+{
+    if (region_starts.empty())
+        return;
+    std::size_t start = region_starts.back();
+    region_starts.pop_back();
+    for (std::size_t i = start; i < region_objects.size(); ++i)
+    {
+        std::size_t bytes = region_objects[i]->size_bytes();
+        live_bytes -= std::min(live_bytes, bytes);
+        gc_stats.objects_released++;
+        gc_stats.bytes_released += bytes;
+        delete region_objects[i];
+    }
+    region_objects.resize(start);
+}
+
+void Heap::mark(HeapObject *obj)
+{
+    if (!obj || obj->marked)
+        return;
+    obj->marked = true;
+    gray.push_back(obj);
+}
+
+void Heap::collect(const std::function<void(Heap &)> &mark_roots)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    mark_roots(*this);
+
+    // Propaga as marcas a partir das raízes.
+    while (!gray.empty())
+    {
+        HeapObject *obj = gray.back();
+        gray.pop_back();
+        obj->trace(*this);
+    }
+
+    sweep();
+
+    // O próximo ciclo acontece quando o heap dobrar em relação ao que sobreviveu.
+    next_collection = std::max(base_threshold, live_bytes * 2);
+
+    double pause = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    gc_stats.collections++;
+    gc_stats.total_pause_ms += pause;
+    gc_stats.max_pause_ms = std::max(gc_stats.max_pause_ms, pause);
+}
+
+void Heap::sweep()
+{
+    std::size_t kept = 0;
+    live_bytes = 0;
+    for (HeapObject *obj : objects)
+    {
+        if (obj->marked)
+        {
+            obj->marked = false;
+            live_bytes += obj->size_bytes();
+            objects[kept++] = obj;
+        }
+        else
+        {
+            gc_stats.objects_reclaimed++;
+            gc_stats.bytes_reclaimed += obj->size_bytes();
+            delete obj;
+        }
+    }
+    objects.resize(kept);
+
+    // Regiões: mesma varredura, ajustando o início de cada região à
+    // compactação do vetor.
+    kept = 0;
+    std::size_t r = 0;
+    for (std::size_t i = 0; i < region_objects.size(); ++i)
+    {
+        while (r < region_starts.size() && region_starts[r] == i)
+            region_starts[r++] = kept;
+        HeapObject *obj = region_objects[i];
+        if (obj->marked)
+        {
+            obj->marked = false;
+            live_bytes += obj->size_bytes();
+            region_objects[kept++] = obj;
+        }
+        else
+        {
+            gc_stats.objects_reclaimed++;
+            gc_stats.bytes_reclaimed += obj->size_bytes();
+            delete obj;
+        }
+    }
+    while (r < region_starts.size())
+        region_starts[r++] = kept;
+    region_objects.resize(kept);
+}
+
+void Heap::print_stats(std::ostream &os) const
+{
+    const GcStats &s = gc_stats;
+    double avg = s.collections ? s.total_pause_ms / s.collections : 0.0;
+    os << "[gc] coletas: " << s.collections
+       << ", pausa total: " << s.total_pause_ms << " ms"
+       << " (média " << avg << " ms, máx " << s.max_pause_ms << " ms)\n"
+       << "[gc] alocados: " << s.objects_allocated << " objetos / " << s.bytes_allocated << " bytes\n"
+       << "[gc] liberados: " << s.objects_reclaimed << " objetos / " << s.bytes_reclaimed << " bytes\n"
+       << "[gc] liberados ao fim das chamadas: " << s.objects_released << " objetos / " << s.bytes_released << " bytes\n"
+       << "[gc] vivos ao final: " << live_object_count() << " objetos / " << live_bytes << " bytes"
+       << " (pico " << s.peak_live_bytes << " bytes, limiar " << base_threshold << " bytes)\n";
+}
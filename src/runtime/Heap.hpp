@@ -0,0 +1,116 @@
+#ifndef HEAP_HPP
+#define HEAP_HPP
+
+#include "Value.hpp"
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+// Categorias dos objetos do heap nas contas de alocação (--mem-stats):
+// registros, arrays de Values e arrays compactados de cada primitivo.
+enum class HeapCategory : unsigned char
+{
+    RECORD,
+    ARRAY,
+    ARRAY_INT,
+    ARRAY_FLOAT,
+    ARRAY_CHAR,
+    ARRAY_BOOL,
+    COUNT
+};
+const char *heap_category_name(HeapCategory category);
+
+struct AllocCount
+{
+    std::size_t objects = 0;
+    std::size_t bytes = 0;
+};
+
+// Estatísticas acumuladas pelo coletor (relatadas com --gc-stats e --mem-stats).
+struct GcStats
+{
+    std::size_t collections = 0;
+    double total_pause_ms = 0.0;
+    double max_pause_ms = 0.0;
+    std::size_t objects_allocated = 0;
+    std::size_t bytes_allocated = 0;
+    std::size_t objects_reclaimed = 0;
+    std::size_t bytes_reclaimed = 0;
+    std::size_t peak_live_bytes = 0;
+    std::size_t objects_released = 0; // liberados na saída da chamada (regiões)
+    std::size_t bytes_released = 0;
+    std::size_t peak_live_objects = 0;
+    AllocCount allocated_by[static_cast<std::size_t>(HeapCategory::COUNT)];
+};
+
+// Heap dos registros e arrays, com coleta mark-sweep.
+// Quem usa o heap informa as raízes no momento da coleta (ver collect());
+// a coleta só é disparada em pontos seguros escolhidos pelo interpretador.
+class Heap
+{
+public:
+    static constexpr std::size_t DEFAULT_THRESHOLD = 8 * 1024 * 1024; // 8 MiB
+
+    explicit Heap(std::size_t threshold = DEFAULT_THRESHOLD);
+    ~Heap();
+
+    Heap(const Heap &) = delete;
+    Heap &operator=(const Heap &) = delete;
+
+    template <typename T, typename... Args>
+    T *make(Args &&...args)
+    {
+        T *obj = new T(std::forward<Args>(args)...);
+        track(obj);
+        return obj;
+    }
+
+    // --- Regiões por chamada ---
+    // Objetos que a análise de escape provou não sobreviverem à chamada que
+    // os criou ficam na região do frame e são liberados todos juntos quando
+    // ela termina, sem esperar uma coleta. Continuam visíveis ao coletor:
+    // se morrerem antes (ex.: dentro de um laço) a coleta os libera também.
+    void push_region() { region_starts.push_back(region_objects.size()); }
+    void pop_region();
+    // Move 'obj', que deve ser o último objeto criado por make(), para a
+    // região do topo. Sem região aberta, ele continua no heap comum.
+    void to_region(HeapObject *obj);
+
+    // Verdadeiro quando os bytes vivos ultrapassam o limiar da próxima coleta.
+    bool needs_collection() const { return live_bytes >= next_collection; }
+
+    // Executa uma coleta completa. 'mark_roots' deve chamar mark() para cada raiz.
+    void collect(const std::function<void(Heap &)> &mark_roots);
+
+    void mark(const Value &v)
+    {
+        if (v.is_ref())
+            mark(v.ref);
+    }
+    void mark(HeapObject *obj);
+
+    std::size_t threshold() const { return base_threshold; }
+    std::size_t live_object_count() const { return objects.size() + region_objects.size(); }
+    std::size_t live_byte_count() const { return live_bytes; }
+    const GcStats &stats() const { return gc_stats; }
+    void print_stats(std::ostream &os) const;
+
+private:
+    std::vector<HeapObject *> objects;
+    std::vector<HeapObject *> gray; // objetos marcados cujos filhos ainda não foram visitados
+    // Objetos de todas as regiões abertas, em ordem de pilha; region_starts
+    // guarda onde começa cada região.
+    std::vector<HeapObject *> region_objects;
+    std::vector<std::size_t> region_starts;
+    std::size_t live_bytes = 0;
+    std::size_t base_threshold;
+    std::size_t next_collection;
+    GcStats gc_stats;
+
+    void track(HeapObject *obj);
+    void sweep();
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "Input.hpp"
+#include "Output.hpp"
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+Scanner::Scanner(int fd) : fd(fd)
+{
+    // Arquivo redirecionado: mapeia a partir da posição atual do descritor.
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        off_t offset = ::lseek(fd, 0, SEEK_CUR);
+        if (offset >= 0 && offset < st.st_size)
+        {
+            void *p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                mapping = p;
+                mapping_size = static_cast<std::size_t>(st.st_size);
+                cur = static_cast<const char *>(p) + offset;
+                end = static_cast<const char *>(p) + mapping_size;
+                at_eof = true; // não há o que recarregar
+                return;
+            }
+        }
+        else if (offset >= st.st_size)
+        {
+            at_eof = true;
+            return;
+        }
+    }
+    storage.resize(CHUNK_SIZE);
+    cur = end = storage.data();
+}
+
+Scanner::~Scanner()
+{
+    if (mapping)
+        ::munmap(mapping, mapping_size);
+}
+
+Scanner &Scanner::standard()
+{
+    static Scanner in(STDIN_FILENO);
+    return in;
+}
+
+bool Scanner::refill()
+{
+    if (at_eof)
+        return false;
+    // Vamos bloquear esperando a entrada: o que já foi impresso aparece antes.
+    Output::standard().flush_for_input();
+
+    // Mantém o trecho ainda não consumido (um token partido entre blocos).
+    std::size_t pending = static_cast<std::size_t>(end - cur);
+    std::memmove(storage.data(), cur, pending);
+    if (pending == storage.size())
+        storage.resize(storage.size() * 2);
+    char *base = storage.data();
+
+    ssize_t n;
+    do
+        n = ::read(fd, base + pending, storage.size() - pending);
+    while (n < 0 && errno == EINTR);
+
+    cur = base;
+    end = base + pending;
+    if (n <= 0)
+    {
+        at_eof = true;
+        return false;
+    }
+    end += n;
+    return true;
+}
+
+bool Scanner::skip_space()
+{
+    for (;;)
+    {
+        while (cur < end && is_space(*cur))
+            ++cur;
+        if (cur < end)
+            return true;
+        if (!refill())
+            return false;
+    }
+}
+
+std::size_t Scanner::token_length()
+{
+    std::size_t n = 0;
+    for (;;)
+    {
+        while (cur + n < end && !is_space(cur[n]))
+            ++n;
+        if (cur + n < end || !refill())
+            return n;
+    }
+}
+
+bool Scanner::ready()
+{
+    if (!failed && !skip_space())
+        failed = true; // fim da entrada
+    return !failed;
+}
+
+bool Scanner::read_int(int &v)
+{
+    if (!ready())
+        return false;
+    std::size_t length = token_length(); // pode recarregar o buffer e mover cur
+    const char *first = cur;
+    const char *last = cur + length;
+    // O iostream aceita '+' antes do número; from_chars não.
+    if (*first == '+' && last - first > 1 && first[1] != '-')
+        ++first;
+    long long value = 0;
+    auto res = std::from_chars(first, last, value);
+    if (res.ec == std::errc::invalid_argument)
+    {
+        v = 0;
+        failed = true;
+        return false;
+    }
+    cur = res.ptr;
+    if (res.ec == std::errc::result_out_of_range || value > INT_MAX || value < INT_MIN)
+    {
+        // Como o iostream: satura e marca a falha.
+        v = *first == '-' ? INT_MIN : INT_MAX;
+        failed = true;
+        return false;
+    }
+    v = static_cast<int>(value);
+    return true;
+}
+
+bool Scanner::read_float(float &v)
+{
+    if (!ready())
+        return false;
+    std::size_t length = token_length(); // pode recarregar o buffer e mover cur
+    const char *first = cur;
+    const char *last = cur + length;
+    if (*first == '+' && last - first > 1 && first[1] != '-')
+        ++first;
+    float value = 0.0f;
+    auto res = std::from_chars(first, last, value);
+    if (res.ec != std::errc())
+    {
+        if (res.ec == std::errc::result_out_of_range)
+            cur = res.ptr;
+        v = 0.0f;
+        failed = true;
+        return false;
+    }
+    cur = res.ptr;
+    v = value;
+    return true;
+}
+
+bool Scanner::read_char(char &c)
+{
+    if (!ready())
+        return false;
+    c = *cur++;
+    return true;
+}
+
+bool Scanner::read_token(std::string &token)
+{
+    if (!ready())
+        return false;
+    std::size_t n = token_length();
+    token.assign(cur, n);
+    cur += n;
+    return true;
+}
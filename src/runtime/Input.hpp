@@ -0,0 +1,123 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+#include "Value.hpp"
+#include "../typecheck/Primitive.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Leitor da entrada do comando `read`, no lugar de std::cin. Quando stdin é
+// um arquivo comum ele é mapeado inteiro com mmap; caso contrário (pipe,
+// terminal) é lido em blocos de 64 KiB. Os números são convertidos com
+// std::from_chars direto do buffer, sem locale nem sentry.
+//
+// Reproduz o `>>` do iostream: espaços são pulados, um número consome o
+// maior prefixo válido (o resto fica para a próxima leitura) e uma leitura
+// que falha escreve zero no alvo. No fim da entrada, ou depois de uma falha,
+// as leituras seguintes não fazem nada.
+class Scanner
+{
+public:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    explicit Scanner(int fd);
+    ~Scanner();
+    Scanner(const Scanner &) = delete;
+    Scanner &operator=(const Scanner &) = delete;
+
+    // Entrada padrão do programa interpretado.
+    static Scanner &standard();
+
+    bool read_int(int &v);
+    bool read_float(float &v);
+    bool read_char(char &c);
+    bool read_token(std::string &token); // sequência sem espaços
+
+private:
+    int fd;
+    const char *cur = nullptr;
+    const char *end = nullptr;
+    bool at_eof = false;
+    bool failed = false;
+    std::vector<char> storage; // leitura em blocos
+    void *mapping = nullptr;   // arquivo mapeado
+    std::size_t mapping_size = 0;
+
+    bool refill();              // false quando não há mais dados
+    bool skip_space();          // false no fim da entrada
+    bool ready();               // pula espaços; false se não há o que ler
+    std::size_t token_length(); // bytes até o próximo espaço, com o token inteiro no buffer
+};
+
+// Valor inicial de uma variável criada por `read`, conforme o tipo que o
+// TypeChecker inferiu para ela (VOID: tipo não decidido, vem da entrada).
+inline Value default_for(Primitive type)
+{
+    switch (type)
+    {
+    case Primitive::INT:
+        return Value::make_int(0);
+    case Primitive::FLOAT:
+        return Value::make_float(0.0f);
+    case Primitive::CHAR:
+        return Value::make_char('\0');
+    case Primitive::BOOL:
+        return Value::make_bool(false);
+    default:
+        return Value();
+    }
+}
+
+// Implementa o comando `read`. Uma variável já tipada lê conforme o seu
+// tipo (Bool, registros e arrays são ignorados); uma variável ainda sem
+// valor, criada pelo próprio `read`, recebe o tipo do texto lido:
+// Int, Float ou, caso contrário, o primeiro caractere.
+inline void read_value(Scanner &in, Value &target)
+{
+    switch (target.kind)
+    {
+    case ValueKind::INT:
+        in.read_int(target.i);
+        break;
+    case ValueKind::FLOAT:
+        in.read_float(target.f);
+        break;
+    case ValueKind::CHAR:
+        in.read_char(target.c);
+        break;
+    case ValueKind::NIL:
+    {
+        std::string token;
+        if (!in.read_token(token))
+            break;
+        char *end = nullptr;
+        long as_int = std::strtol(token.c_str(), &end, 10);
+        if (*end == '\0')
+        {
+            target = Value::make_int(static_cast<int>(as_int));
+            break;
+        }
+        float as_float = std::strtof(token.c_str(), &end);
+        if (*end == '\0')
+            target = Value::make_float(as_float);
+        else
+            target = Value::make_char(token[0]);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// `read` para um campo ou elemento cujo tipo estático é 'type'. Um alvo
+// ainda null (elemento de array genérico) recebe antes o valor padrão do
+// tipo; se o tipo não é primitivo nada é lido.
+inline void read_into(Scanner &in, Value &target, Primitive type)
+{
+    if (target.is_nil())
+        target = default_for(type);
+    if (!target.is_nil())
+        read_value(in, target);
+}
+#endif
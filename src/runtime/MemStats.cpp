@@ -0,0 +1,45 @@
+#include "MemStats.hpp"
+#include "Value.hpp"
+#include <ostream>
+
+void print_mem_stats(std::ostream &os, const char *engine, const Heap &heap, const StackStats &stack)
+{
+    const GcStats &s = heap.stats();
+    const std::size_t categories = static_cast<std::size_t>(HeapCategory::COUNT);
+
+    for (std::size_t k = 0; k < categories; ++k)
+    {
+        const AllocCount &count = s.allocated_by[k];
+        if (count.objects > 0)
+            os << "[mem] alocados " << heap_category_name(static_cast<HeapCategory>(k)) << ": "
+               << count.objects << " objetos / " << count.bytes << " bytes\n";
+    }
+    os << "[mem] heap: pico de " << s.peak_live_objects << " objetos / " << s.peak_live_bytes
+       << " bytes vivos; ao final " << heap.live_object_count() << " objetos / " << heap.live_byte_count() << " bytes\n"
+       << "[mem] pilha: pico de " << stack.peak_slots << " valores (" << stack.peak_slots * sizeof(Value)
+       << " bytes), " << stack.peak_depth << " chamadas ativas; " << stack.calls << " chamadas\n";
+
+    os << "{\"mem_stats\": {\"engine\": \"" << engine << "\", \"value_bytes\": " << sizeof(Value)
+       << ", \"heap\": {\"allocated\": {";
+    for (std::size_t k = 0; k < categories; ++k)
+    {
+        const AllocCount &count = s.allocated_by[k];
+        os << (k ? ", " : "") << '"' << heap_category_name(static_cast<HeapCategory>(k)) << "\": {\"objects\": "
+           << count.objects << ", \"bytes\": " << count.bytes << '}';
+    }
+    os << "}, \"total_objects\": " << s.objects_allocated << ", \"total_bytes\": " << s.bytes_allocated
+       << ", \"peak_live_objects\": " << s.peak_live_objects << ", \"peak_live_bytes\": " << s.peak_live_bytes
+       << ", \"live_objects\": " << heap.live_object_count() << ", \"live_bytes\": " << heap.live_byte_count()
+       << ", \"collections\": " << s.collections << "}, \"stack\": {\"calls\": " << stack.calls
+       << ", \"peak_depth\": " << stack.peak_depth << ", \"peak_slots\": " << stack.peak_slots
+       << ", \"peak_bytes\": " << stack.peak_slots * sizeof(Value) << "}}}\n";
+}
+
+void print_mem_snapshot(std::ostream &os, const Heap &heap, const StackStats &stack)
+{
+    const GcStats &s = heap.stats();
+    os << "{\"mem_snapshot\": {\"collections\": " << s.collections
+       << ", \"live_objects\": " << heap.live_object_count() << ", \"live_bytes\": " << heap.live_byte_count()
+       << ", \"allocated_bytes\": " << s.bytes_allocated << ", \"peak_live_bytes\": " << s.peak_live_bytes
+       << ", \"stack_peak_slots\": " << stack.peak_slots << ", \"stack_peak_depth\": " << stack.peak_depth << "}}\n";
+}
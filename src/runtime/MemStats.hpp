@@ -0,0 +1,35 @@
+#ifndef MEM_STATS_HPP
+#define MEM_STATS_HPP
+
+#include "Heap.hpp"
+#include <cstddef>
+#include <iosfwd>
+
+// Uso da pilha de execução, acompanhado a cada chamada (--mem-stats). No
+// interpretador os slots são os locais dos frames; na VM, locais e operandos.
+struct StackStats
+{
+    std::size_t calls = 0;      // corpos de função executados (com as chamadas de cauda)
+    std::size_t peak_depth = 0; // máximo de chamadas ativas
+    std::size_t peak_slots = 0; // máximo de Values reservados na pilha
+
+    void enter(std::size_t depth, std::size_t slots)
+    {
+        ++calls;
+        if (depth > peak_depth)
+            peak_depth = depth;
+        if (slots > peak_slots)
+            peak_slots = slots;
+    }
+};
+
+// Relatório final de --mem-stats em stderr: linhas "[mem]" legíveis e um
+// bloco JSON numa única linha ({"mem_stats": {...}}). 'engine' é
+// "interpreter" ou "vm".
+void print_mem_stats(std::ostream &os, const char *engine, const Heap &heap, const StackStats &stack);
+
+// Estado atual numa linha JSON ({"mem_snapshot": {...}}), para --mem-stats=N
+// (emitido a cada N coletas).
+void print_mem_snapshot(std::ostream &os, const Heap &heap, const StackStats &stack);
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef MEMO_CACHE_HPP
+#define MEMO_CACHE_HPP
+#include "Value.hpp"
+#include <cstddef>
+#include <list>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Resultados já calculados de uma função pura (--memoize), indexados pelos
+// valores primitivos dos argumentos. Guarda no máximo 'capacity' entradas e
+// descarta a usada há mais tempo (LRU). Só valores primitivos entram, então
+// o coletor não precisa enxergar o cache.
+class MemoCache
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    explicit MemoCache(std::size_t capacity = DEFAULT_CAPACITY) : capacity(capacity) {}
+
+    // Chave dos argumentos: tipo e bits de cada valor.
+    static std::string key_of(const Value *args, std::size_t count)
+    {
+        std::string key;
+        key.reserve(count * 5);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const Value &v = args[k];
+            key.push_back(static_cast<char>(v.kind));
+            if (v.is_int())
+                key.append(reinterpret_cast<const char *>(&v.i), sizeof(v.i));
+            else if (v.is_float())
+                key.append(reinterpret_cast<const char *>(&v.f), sizeof(v.f));
+            else if (v.is_char())
+                key.push_back(v.c);
+            else if (v.is_bool())
+                key.push_back(v.b ? 1 : 0);
+        }
+        return key;
+    }
+
+    // Resultados guardados para 'key' (a entrada passa a ser a mais recente),
+    // ou nullptr. Conta acertos e faltas.
+    const std::vector<Value> *find(const std::string &key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    void insert(const std::string &key, const std::vector<Value> &results)
+    {
+        for (const Value &v : results)
+            if (v.is_ref())
+                return;
+        if (capacity == 0 || index.count(key))
+            return;
+        if (entries.size() == capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++evictions;
+        }
+        entries.emplace_front(key, results);
+        index.emplace(key, entries.begin());
+    }
+
+    std::size_t size() const { return entries.size(); }
+
+    void print_stats(std::ostream &os, const std::string &function) const
+    {
+        os << "[memo] " << function << ": " << hits << " acertos, " << misses << " faltas, "
+           << evictions << " descartes (" << entries.size() << " entradas)\n";
+    }
+
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+
+private:
+    using Entry = std::pair<std::string, std::vector<Value>>;
+    std::size_t capacity;
+    std::list<Entry> entries; // da mais recente para a mais antiga
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+#endif
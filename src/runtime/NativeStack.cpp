@@ -0,0 +1,109 @@
+#include "NativeStack.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+std::string stack_overflow_message(std::size_t max_stack)
+{
+    return "Erro de Execução: Estouro da pilha de chamadas (limite de " + std::to_string(max_stack) +
+           " chamadas ativas; ajuste com --max-stack=N).";
+}
+
+std::string native_stack_exhausted_message(std::size_t depth)
+{
+    return "Erro de Execução: Estouro da pilha nativa do interpretador com " + std::to_string(depth) +
+           " chamadas ativas (memória insuficiente para o limite de --max-stack; tente -vm).";
+}
+
+namespace
+{
+    struct Job
+    {
+        const std::function<void(std::size_t)> *body;
+        std::size_t bytes;
+        std::exception_ptr error;
+    };
+
+    void *run_job(void *arg)
+    {
+        Job *job = static_cast<Job *>(arg);
+        try
+        {
+            (*job->body)(job->bytes);
+        }
+        catch (...)
+        {
+            job->error = std::current_exception();
+        }
+        return nullptr;
+    }
+
+    // Bytes da pilha da thread atual abaixo deste ponto; 0 se desconhecido.
+    std::size_t remaining_stack()
+    {
+        char here;
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0)
+        {
+            void *low = nullptr;
+            std::size_t size = 0;
+            bool known = pthread_attr_getstack(&attr, &low, &size) == 0;
+            pthread_attr_destroy(&attr);
+            if (known && &here > static_cast<char *>(low))
+                return static_cast<std::size_t>(&here - static_cast<char *>(low));
+        }
+        // Sem a posição da pilha, só o limite: metade dele, pelo que já foi usado.
+        struct rlimit limit;
+        if (::getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+            return static_cast<std::size_t>(limit.rlim_cur) / 2;
+        return 0;
+    }
+}
+
+void run_on_native_stack(std::size_t bytes, const std::function<void(std::size_t)> &body)
+{
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t min_bytes = 1024 * 1024;
+    bytes = std::min(bytes, SIZE_MAX / 4);
+    bytes = (bytes + page - 1) / page * page + page; // + página de guarda
+
+    // Com `ulimit -v` ou pouca memória virtual, uma pilha menor ainda serve:
+    // as chamadas que não couberem viram erro de execução (ver native_floor).
+    void *stack = MAP_FAILED;
+    for (; bytes >= min_bytes; bytes = (bytes / 2 + page - 1) / page * page)
+    {
+        stack = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+        if (stack != MAP_FAILED)
+            break;
+    }
+    if (stack == MAP_FAILED)
+    {
+        body(remaining_stack()); // sem memória para a pilha: usa a da thread atual
+        return;
+    }
+    ::mprotect(stack, page, PROT_NONE);
+
+    Job job{&body, bytes - page, nullptr};
+    pthread_attr_t attr;
+    pthread_t thread;
+    bool started = false;
+    if (pthread_attr_init(&attr) == 0)
+    {
+        started = pthread_attr_setstack(&attr, stack, bytes) == 0 &&
+                  pthread_create(&thread, &attr, run_job, &job) == 0;
+        pthread_attr_destroy(&attr);
+    }
+    if (started)
+        pthread_join(thread, nullptr);
+    ::munmap(stack, bytes);
+
+    if (!started)
+        body(remaining_stack());
+    else if (job.error)
+        std::rethrow_exception(job.error);
+}
@@ -0,0 +1,29 @@
+#ifndef NATIVE_STACK_HPP
+#define NATIVE_STACK_HPP
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Limite de chamadas ativas da linguagem (--max-stack), no interpretador e na VM.
+constexpr std::size_t DEFAULT_MAX_STACK = 1000000;
+// Maior valor aceito por --max-stack.
+constexpr std::size_t MAX_STACK_LIMIT = 100000000;
+
+// Mensagem do erro de execução quando o limite é ultrapassado.
+std::string stack_overflow_message(std::size_t max_stack);
+// Mensagem quando a pilha nativa do interpretador acaba antes do limite
+// (não houve memória para reservá-la inteira, ou o corpo é muito aninhado).
+std::string native_stack_exhausted_message(std::size_t depth);
+
+// Executa 'body' numa thread com uma pilha nativa de 'bytes' bytes, reservada
+// com mmap (só as páginas tocadas ocupam memória). O interpretador percorre a
+// AST recursivamente, então a profundidade de recursão da linguagem depende
+// do tamanho dessa pilha, não da pilha da thread principal.
+// Se não há endereços para 'bytes', tenta a metade, e assim por diante.
+// 'body' recebe quantos bytes de pilha tem disponíveis: o tamanho da pilha
+// criada ou, se nenhuma pôde ser criada, o que resta da pilha da thread
+// atual, onde ele roda (0 só se nem isso pôde ser determinado). Uma exceção
+// lançada por 'body' é relançada na thread que chamou.
+void run_on_native_stack(std::size_t bytes, const std::function<void(std::size_t)> &body);
+
+#endif
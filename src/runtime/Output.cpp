@@ -0,0 +1,96 @@
+#include "Output.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+Output::Output(int fd)
+    : fd(fd), is_tty(::isatty(fd) == 1), line_flush(is_tty)
+{
+}
+
+Output::~Output()
+{
+    flush();
+}
+
+Output &Output::standard()
+{
+    static Output out(STDOUT_FILENO);
+    return out;
+}
+
+void Output::write(const char *data, std::size_t n)
+{
+    if (n > BUFFER_SIZE - used)
+    {
+        flush();
+        if (n >= BUFFER_SIZE)
+        {
+            // Grande demais para o buffer: vai direto.
+            while (n > 0)
+            {
+                ssize_t w = ::write(fd, data, n);
+                if (w < 0 && errno == EINTR)
+                    continue;
+                if (w <= 0)
+                    return;
+                data += w;
+                n -= static_cast<std::size_t>(w);
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer + used, data, n);
+    used += n;
+}
+
+void Output::write(const char *text)
+{
+    write(text, std::strlen(text));
+}
+
+void Output::write_int(long v)
+{
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    write(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void Output::write_float(float v)
+{
+    char tmp[48];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v, std::chars_format::general, 6);
+    write(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void Output::write_pointer(const void *p)
+{
+    char tmp[2 + 2 * sizeof(void *)] = {'0', 'x'};
+    auto res = std::to_chars(tmp + 2, tmp + sizeof(tmp), reinterpret_cast<std::uintptr_t>(p), 16);
+    write(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void Output::flush()
+{
+    const char *data = buffer;
+    std::size_t n = used;
+    while (n > 0)
+    {
+        ssize_t w = ::write(fd, data, n);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w <= 0)
+            break; // saída fechada: descarta, como faria o cout
+        data += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    used = 0;
+}
+
+void Output::flush_for_input()
+{
+    if (used > 0)
+        flush();
+}
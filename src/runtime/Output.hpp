@@ -0,0 +1,59 @@
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+#include <cstddef>
+
+// Saída do comando `print`. Em vez de std::cout + std::endl (um flush e
+// uma chamada de sistema por linha), acumula tudo num buffer próprio e só
+// escreve quando ele enche, no fim da execução, antes de um `read` ter de
+// esperar pela entrada ou quando pedido com flush(). Se a saída é um
+// terminal, ou com --unbuffered, cada linha é escrita ao terminar.
+// Números são formatados com std::to_chars.
+class Output
+{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit Output(int fd);
+    ~Output(); // escreve o que restou
+    Output(const Output &) = delete;
+    Output &operator=(const Output &) = delete;
+
+    // Saída padrão do programa interpretado.
+    static Output &standard();
+
+    void set_unbuffered(bool on) { line_flush = on || is_tty; }
+
+    void put(char c)
+    {
+        if (used == BUFFER_SIZE)
+            flush();
+        buffer[used++] = c;
+    }
+    void write(const char *data, std::size_t n);
+    void write(const char *text);
+    void write_int(long v);
+    void write_float(float v); // mesmo formato de `std::cout << v` (%g, 6 dígitos)
+    void write_pointer(const void *p);
+
+    // Fim de um `print`: quebra de linha e, se for o caso, flush.
+    void end_line()
+    {
+        put('\n');
+        if (line_flush)
+            flush();
+    }
+
+    void flush();
+    // Chamado antes de bloquear lendo a entrada: o que já foi impresso
+    // (prompts) precisa chegar a quem vai responder, seja um terminal ou
+    // outro processo ligado por pipes. Só acontece a cada bloco lido.
+    void flush_for_input();
+
+private:
+    int fd;
+    bool is_tty;
+    bool line_flush;
+    std::size_t used = 0;
+    char buffer[BUFFER_SIZE];
+};
+#endif
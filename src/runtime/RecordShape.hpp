@@ -0,0 +1,26 @@
+#ifndef RECORD_SHAPE_HPP
+#define RECORD_SHAPE_HPP
+
+#include "../ast/Symbol.hpp"
+#include <cstddef>
+#include <vector>
+
+// Descrição de um tipo 'data', compartilhada por todas as suas instâncias:
+// o nome e os campos na ordem da definição. A posição de um campo nessa
+// lista é o seu slot no registro (ver FieldAccessNode::field_slot).
+struct RecordShape
+{
+    Symbol name;
+    std::vector<Symbol> field_names;
+
+    // Slot do campo, ou -1 se ele não existe no tipo.
+    int slot_of(Symbol field) const
+    {
+        for (std::size_t i = 0; i < field_names.size(); ++i)
+            if (field_names[i] == field)
+                return static_cast<int>(i);
+        return -1;
+    }
+};
+
+#endif
@@ -1,32 +1,47 @@
 #ifndef RECORD_VALUE_HPP
 #define RECORD_VALUE_HPP
 
-#include "Value.hpp"
+#include "Heap.hpp"
+#include "RecordShape.hpp"
 #include <string>
-#include <map>
+#include <vector>
+#include <utility>
 
 // Representa uma instância de um tipo 'data' (um registro).
-// É essencialmente um mapa que associa nomes de campos a outros valores.
-class RecordValue : public Value {
+// Os campos ficam num vetor contíguo, indexado pelo slot resolvido na
+// checagem de tipos; os nomes só são consultados na descrição do tipo.
+class RecordValue : public HeapObject {
 public:
-    // O mapa que armazena os campos do registro, ex: "x" -> IntValue*
-    std::map<std::string, Value*> fields;
+    const RecordShape *shape; // pertence ao interpretador ou ao Program da VM
+    std::vector<Value> fields; // fields[i] é o campo shape->field_names[i]
 
-    // O nome do tipo do registro (ex: "Point") para referência futura.
-    std::string type_name;
+    RecordValue(const RecordShape *s, std::vector<Value> f)
+        : HeapObject(ValueKind::RECORD), shape(s), fields(std::move(f)) {}
 
-    explicit RecordValue(const std::string& type) : type_name(type) {}
-
-    // O destrutor do RecordValue não deleta os ponteiros dos campos,
-    // pois a 'value_pool' do interpretador já cuida disso.
+    // O destrutor do RecordValue não deleta os objetos referenciados pelos
+    // campos: quem libera objetos inalcançáveis é o coletor (Heap).
     ~RecordValue() {}
 
-    void print() const override {
+    const std::string &type_name() const { return shape->name.str(); }
+
+    void print(Output& out) const override {
         // Imprime o nome do tipo e o endereço do registro,
         // como é comum em muitas linguagens.
-        // O `this` é um ponteiro, então o convertemos para um tipo que pode ser impresso.
-        std::cout << type_name << "@" << (void*)this;
+        const std::string &name = shape->name.str();
+        out.write(name.data(), name.size());
+        out.put('@');
+        out.write_pointer(this);
+    }
+
+    void trace(Heap& heap) const override {
+        for (const Value& field : fields) heap.mark(field);
+    }
+
+    std::size_t size_bytes() const override {
+        return sizeof(RecordValue) + fields.capacity() * sizeof(Value);
     }
 };
 
-#endif
\ No newline at end of file
+inline RecordValue* Value::as_record() const { return static_cast<RecordValue*>(ref); }
+
+#endif
@@ -1,9 +1,158 @@
 #ifndef VALUE_HPP
 #define VALUE_HPP
-#include <iostream>
-class Value {
+#include "Output.hpp"
+#include <cstddef>
+
+class Heap;
+class ArrayValue;
+class RecordValue;
+
+enum class ValueKind : unsigned char
+{
+    NIL, // null, ou variável sem valor
+    INT,
+    FLOAT,
+    CHAR,
+    BOOL,
+    ARRAY, // ponteiro para um ArrayValue
+    RECORD // ponteiro para um RecordValue
+};
+
+// Base dos objetos que vivem no heap (arrays e registros). Os primitivos
+// não são mais alocados: viajam "unboxed" dentro de Value.
+class HeapObject
+{
 public:
-    virtual ~Value() = default;
-    virtual void print() const = 0;
+    // ARRAY ou RECORD; copiado para o Value que referencia o objeto, de modo
+    // que o interpretador descobre o tipo sem dynamic_cast nem acesso ao heap.
+    const ValueKind kind;
+    bool marked = false; // usado pelo coletor (ver Heap)
+
+    explicit HeapObject(ValueKind k) : kind(k) {}
+    virtual ~HeapObject() = default;
+    virtual void print(Output &out) const = 0;
+    // Marca, via Heap::mark, os objetos referenciados por este.
+    virtual void trace(Heap &heap) const = 0;
+    // Tamanho aproximado do objeto, usado nas contas do coletor.
+    virtual std::size_t size_bytes() const = 0;
+};
+
+// Valor da linguagem com tag: 16 bytes, copiado por valor.
+// Operações aritméticas sobre primitivos não fazem nenhuma alocação.
+struct Value
+{
+    ValueKind kind = ValueKind::NIL;
+    union
+    {
+        int i;
+        float f;
+        char c;
+        bool b;
+        HeapObject *ref;
+    };
+
+    Value() : ref(nullptr) {}
+
+    static Value make_int(int v)
+    {
+        Value r;
+        r.kind = ValueKind::INT;
+        r.i = v;
+        return r;
+    }
+    static Value make_float(float v)
+    {
+        Value r;
+        r.kind = ValueKind::FLOAT;
+        r.f = v;
+        return r;
+    }
+    static Value make_char(char v)
+    {
+        Value r;
+        r.kind = ValueKind::CHAR;
+        r.c = v;
+        return r;
+    }
+    static Value make_bool(bool v)
+    {
+        Value r;
+        r.kind = ValueKind::BOOL;
+        r.b = v;
+        return r;
+    }
+    static Value make_ref(HeapObject *obj)
+    {
+        Value r;
+        if (obj)
+        {
+            r.kind = obj->kind;
+            r.ref = obj;
+        }
+        return r;
+    }
+
+    bool is_nil() const { return kind == ValueKind::NIL; }
+    bool is_int() const { return kind == ValueKind::INT; }
+    bool is_float() const { return kind == ValueKind::FLOAT; }
+    bool is_char() const { return kind == ValueKind::CHAR; }
+    bool is_bool() const { return kind == ValueKind::BOOL; }
+    bool is_array() const { return kind == ValueKind::ARRAY; }
+    bool is_record() const { return kind == ValueKind::RECORD; }
+    bool is_ref() const { return kind >= ValueKind::ARRAY; }
+
+    // Só válidos após is_array()/is_record(); definidos em ArrayValue.hpp e RecordValue.hpp.
+    ArrayValue *as_array() const;
+    RecordValue *as_record() const;
+
+    // Igualdade da linguagem: primitivos comparam o conteúdo,
+    // registros/arrays comparam a identidade (endereço).
+    bool equals(const Value &o) const
+    {
+        if (kind != o.kind)
+            return false;
+        switch (kind)
+        {
+        case ValueKind::NIL:
+            return true;
+        case ValueKind::INT:
+            return i == o.i;
+        case ValueKind::FLOAT:
+            return f == o.f;
+        case ValueKind::CHAR:
+            return c == o.c;
+        case ValueKind::BOOL:
+            return b == o.b;
+        case ValueKind::ARRAY:
+        case ValueKind::RECORD:
+            return ref == o.ref;
+        }
+        return false;
+    }
+
+    void print(Output &out) const
+    {
+        switch (kind)
+        {
+        case ValueKind::NIL:
+            break;
+        case ValueKind::INT:
+            out.write_int(i);
+            break;
+        case ValueKind::FLOAT:
+            out.write_float(f);
+            break;
+        case ValueKind::CHAR:
+            out.put(c);
+            break;
+        case ValueKind::BOOL:
+            out.write(b ? "true" : "false");
+            break;
+        case ValueKind::ARRAY:
+        case ValueKind::RECORD:
+            ref->print(out);
+            break;
+        }
+    }
 };
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,3 @@
 #include "Value.hpp"
-#include "IntValue.hpp"
-#include "BoolValue.hpp"
-#include "FloatValue.hpp"
-#include "CharValue.hpp"
 #include "RecordValue.hpp"
 #include "ArrayValue.hpp"
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "Resolver.hpp"
+#include "../ast/AST.hpp"
+
+// --- Escopos ---
+
+int Resolver::declare(Symbol name)
+{
+    if (int *slot = scopes.find_in_current(name))
+    {
+        return *slot;
+    }
+    return scopes.declare(name, frame_size++);
+}
+
+int Resolver::lookup(Symbol name)
+{
+    int *slot = scopes.find(name);
+    return slot ? *slot : -1;
+}
+
+// --- Ponto de Entrada ---
+
+void Resolver::resolve(ProgramNode *ast)
+{
+    if (ast)
+        ast->accept(this);
+}
+
+void Resolver::visit(ProgramNode *node)
+{
+    for (Node *def : node->definitions)
+    {
+        def->accept(this);
+    }
+}
+
+void Resolver::visit(FunDefNode *node)
+{
+    // Os parâmetros ocupam os primeiros slots, na ordem da declaração.
+    scopes.clear();
+    scopes.push();
+    frame_size = 0;
+    for (const auto &param : node->params)
+    {
+        declare(param.name);
+    }
+    node->body->accept(this);
+    node->frame_size = frame_size;
+    scopes.clear();
+}
+
+void Resolver::visit(DataDefNode *node) {}
+void Resolver::visit(TypeNode *node) {}
+
+// --- Comandos ---
+
+void Resolver::visit(BlockCmdNode *node)
+{
+    scopes.push();
+    for (Command *cmd : node->commands)
+    {
+        cmd->accept(this);
+    }
+    scopes.pop();
+}
+
+void Resolver::visit(VarDeclNode *node)
+{
+    node->slot = declare(node->name);
+}
+
+void Resolver::visit(AssignCmdNode *node)
+{
+    // O lado direito é resolvido antes: em `x = x + 1` com x novo, o x da
+    // direita ainda não existe (como na execução).
+    node->expr->accept(this);
+
+    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    {
+        va->slot = lookup(va->name);
+        if (va->slot < 0)
+        {
+            va->slot = declare(va->name); // inferência: cria no escopo atual
+        }
+        return;
+    }
+    node->lvalue->accept(this);
+}
+
+void Resolver::visit(ReadCmdNode *node)
+{
+    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    {
+        va->slot = lookup(va->name);
+        if (va->slot < 0)
+        {
+            va->slot = declare(va->name);
+            node->declares = true;
+        }
+        return;
+    }
+    node->lvalue->accept(this);
+}
+
+void Resolver::visit(IfCmdNode *node)
+{
+    node->condition->accept(this);
+    node->then_branch->accept(this);
+    if (node->else_branch)
+    {
+        node->else_branch->accept(this);
+    }
+}
+
+void Resolver::visit(IterateCmdNode *node)
+{
+    node->condition->accept(this);
+    if (node->loop_variable.empty())
+    {
+        node->body->accept(this);
+        return;
+    }
+    scopes.push();
+    node->loop_slot = declare(node->loop_variable);
+    node->body->accept(this);
+    scopes.pop();
+}
+
+void Resolver::visit(PrintCmd *node)
+{
+    node->expr->accept(this);
+}
+
+void Resolver::visit(ReturnCmdNode *node)
+{
+    for (Expression *expr : node->expressions)
+    {
+        expr->accept(this);
+    }
+}
+
+void Resolver::visit(FunCallCmdNode *node)
+{
+    for (Expression *arg : node->args)
+    {
+        arg->accept(this);
+    }
+    // As variáveis de captura precisam existir; não são criadas aqui.
+    for (Expression *lval : node->lvalues)
+    {
+        lval->accept(this);
+    }
+}
+
+// --- Expressões ---
+
+void Resolver::visit(VarAccessNode *node)
+{
+    node->slot = lookup(node->name);
+}
+
+void Resolver::visit(FunCallNode *node)
+{
+    for (Expression *arg : node->args)
+    {
+        arg->accept(this);
+    }
+    node->return_index->accept(this);
+}
+
+void Resolver::visit(NewExprNode *node)
+{
+    for (Expression *dim : node->dims)
+    {
+        if (dim)
+            dim->accept(this);
+    }
+}
+
+void Resolver::visit(FieldAccessNode *node)
+{
+    node->record_expr->accept(this);
+}
+
+void Resolver::visit(ArrayAccessNode *node)
+{
+    node->array_expr->accept(this);
+    node->index_expr->accept(this);
+}
+
+void Resolver::visit(UnaryOpNode *node)
+{
+    node->expr->accept(this);
+}
+
+void Resolver::visit(BinaryOpNode *node)
+{
+    node->left->accept(this);
+    node->right->accept(this);
+}
+
+void Resolver::visit(IntLiteral *node) {}
+void Resolver::visit(FloatLiteralNode *node) {}
+void Resolver::visit(CharLiteralNode *node) {}
+void Resolver::visit(BoolLiteralNode *node) {}
+void Resolver::visit(NullLiteralNode *node) {}
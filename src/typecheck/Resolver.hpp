@@ -0,0 +1,55 @@
+#ifndef RESOLVER_HPP
+#define RESOLVER_HPP
+
+#include "../ast/Visitor.hpp"
+#include "ScopeStack.hpp"
+
+// Passo executado após o TypeChecker: associa cada variável a um slot do
+// frame da sua função, seguindo a mesma disciplina de escopos do checador
+// (parâmetros, blocos, variável do iterate). Os índices ficam gravados na
+// AST (VarAccessNode::slot, VarDeclNode::slot, IterateCmdNode::loop_slot) e
+// o tamanho do frame em FunDefNode::frame_size, de modo que nem o
+// interpretador nem a VM procuram nomes em tempo de execução.
+//
+// Cada declaração recebe um slot próprio dentro da função; não há
+// reaproveitamento entre blocos irmãos.
+class Resolver : public Visitor
+{
+public:
+    void resolve(ProgramNode *ast);
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    ScopeStack<int> scopes; // slot de cada variável visível
+    int frame_size = 0;
+
+    int declare(Symbol name);
+    int lookup(Symbol name); // -1 se não declarada
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SCOPE_STACK_HPP
+#define SCOPE_STACK_HPP
+
+#include "../ast/Symbol.hpp"
+#include <cstddef>
+#include <vector>
+
+// Pilha de escopos léxicos (blocos, parâmetros, variável do iterate) usada
+// pelo TypeChecker e pelo Resolver. Em vez de um mapa por escopo, guarda
+// as declarações numa única pilha e, por símbolo, a posição da declaração
+// visível; cada declaração lembra a que ela esconde, restaurada ao fechar o
+// escopo. Procurar um nome é um acesso indexado pelo id, em qualquer
+// profundidade.
+template <typename T>
+class ScopeStack
+{
+public:
+    void push() { scope_starts.push_back(bindings.size()); }
+
+    void pop()
+    {
+        std::size_t start = scope_starts.back();
+        while (bindings.size() > start)
+        {
+            visible[bindings.back().name] = bindings.back().shadowed;
+            bindings.pop_back();
+        }
+        scope_starts.pop_back();
+    }
+
+    void clear()
+    {
+        while (!scope_starts.empty())
+            pop();
+    }
+
+    bool empty() const { return scope_starts.empty(); }
+    std::size_t depth() const { return scope_starts.size(); }
+
+    // Declaração visível do nome, ou nullptr.
+    T *find(Symbol name)
+    {
+        std::size_t pos = visible.get(name);
+        return pos ? &bindings[pos - 1].value : nullptr;
+    }
+
+    // Declaração do nome feita no escopo mais interno, ou nullptr.
+    T *find_in_current(Symbol name)
+    {
+        std::size_t pos = visible.get(name);
+        return pos > scope_starts.back() ? &bindings[pos - 1].value : nullptr;
+    }
+
+    T &declare(Symbol name, T value)
+    {
+        bindings.push_back({name, std::move(value), visible.get(name)});
+        visible[name] = bindings.size();
+        return bindings.back().value;
+    }
+
+private:
+    struct Binding
+    {
+        Symbol name;
+        T value;
+        std::size_t shadowed; // posição (+1) da declaração escondida, 0 se nenhuma
+    };
+    std::vector<Binding> bindings;
+    std::vector<std::size_t> scope_starts;
+    SymbolMap<std::size_t> visible; // posição (+1) em bindings; 0: não declarada
+};
+
+#endif
@@ -2,9 +2,9 @@
 #define TYPE_HPP
 
 #include "Primitive.hpp" // enum class Primitive { INT, FLOAT, CHAR, BOOL, VOID }
+#include "../ast/Symbol.hpp"
 #include <string>
 #include <vector>
-#include <map>
 #include <memory>
 
 /* ============================================================
@@ -66,12 +66,30 @@ public:
 class RecordType : public Type
 {
 public:
-    std::string name;
-    std::map<std::string, std::shared_ptr<Type>> fields;
+    Symbol name;
+    // Campos na ordem da definição: o índice de um campo aqui é o seu slot
+    // no registro. field_types[i] é o tipo de field_order[i].
+    std::vector<Symbol> field_order;
+    std::vector<std::shared_ptr<Type>> field_types;
 
-    explicit RecordType(const std::string &n) : name(n) {}
+    explicit RecordType(Symbol n) : name(n) {}
 
-    std::string to_string() const override { return name; }
+    int slot_of(Symbol field) const
+    {
+        for (size_t i = 0; i < field_order.size(); ++i)
+            if (field_order[i] == field)
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    // Tipo do campo, ou nullptr se ele não existe.
+    std::shared_ptr<Type> field_type(Symbol field) const
+    {
+        int slot = slot_of(field);
+        return slot < 0 ? nullptr : field_types[slot];
+    }
+
+    std::string to_string() const override { return name.str(); }
     TypeKind kind() const override { return TypeKind::RECORD; }
 };
 
@@ -14,6 +14,63 @@ static std::string idx_str(std::size_t i)
     return os.str();
 }
 
+/* =============================================================
+ *  Especialização de operadores (ver BinarySpec/UnarySpec)
+ * ===========================================================*/
+static BinarySpec binary_spec(char op, Primitive l, Primitive r)
+{
+    if (l != r)
+        return BinarySpec::GENERIC; // Int/Float misturados: promoção em tempo de execução
+
+    switch (l)
+    {
+    case Primitive::INT:
+        switch (op)
+        {
+        case '+': return BinarySpec::INT_ADD;
+        case '-': return BinarySpec::INT_SUB;
+        case '*': return BinarySpec::INT_MUL;
+        case '/': return BinarySpec::INT_DIV;
+        case '%': return BinarySpec::INT_MOD;
+        case '<': return BinarySpec::INT_LT;
+        case '>': return BinarySpec::INT_GT;
+        case '=': return BinarySpec::INT_EQ;
+        case 'n': return BinarySpec::INT_NE;
+        }
+        break;
+    case Primitive::FLOAT:
+        switch (op)
+        {
+        case '+': return BinarySpec::FLOAT_ADD;
+        case '-': return BinarySpec::FLOAT_SUB;
+        case '*': return BinarySpec::FLOAT_MUL;
+        case '/': return BinarySpec::FLOAT_DIV;
+        case '<': return BinarySpec::FLOAT_LT;
+        case '>': return BinarySpec::FLOAT_GT;
+        case '=': return BinarySpec::FLOAT_EQ;
+        case 'n': return BinarySpec::FLOAT_NE;
+        }
+        break;
+    case Primitive::CHAR:
+        if (op == '=')
+            return BinarySpec::CHAR_EQ;
+        if (op == 'n')
+            return BinarySpec::CHAR_NE;
+        break;
+    case Primitive::BOOL:
+        if (op == '=')
+            return BinarySpec::BOOL_EQ;
+        if (op == 'n')
+            return BinarySpec::BOOL_NE;
+        if (op == '&')
+            return BinarySpec::BOOL_AND;
+        break;
+    default:
+        break;
+    }
+    return BinarySpec::GENERIC;
+}
+
 // --- Construtor e Métodos Auxiliares ---
 
 TypeChecker::TypeChecker()
@@ -23,40 +80,67 @@ TypeChecker::TypeChecker()
 
 void TypeChecker::push_scope()
 {
-    variable_types.emplace_back();
+    variable_types.push();
 }
 
 void TypeChecker::pop_scope()
 {
-    if (!variable_types.empty())
+    if (variable_types.empty())
+    {
+        return;
+    }
+    std::size_t scope = variable_types.depth() - 1;
+    while (!pending_reads.empty() && pending_reads.back().scope == scope)
     {
-        variable_types.pop_back();
+        const PendingRead &pending = pending_reads.back();
+        auto type = *variable_types.find_in_current(pending.name);
+        if (type->is_primitive())
+        {
+            pending.node->declared_type = std::static_pointer_cast<PrimitiveType>(type)->p_type;
+        }
+        pending_reads.pop_back();
     }
+    variable_types.pop();
 }
 
-void TypeChecker::add_variable(const std::string &name, std::shared_ptr<Type> type)
+void TypeChecker::add_variable(Symbol name, std::shared_ptr<Type> type)
 {
     if (!variable_types.empty())
     {
         // Verifica se a variável já foi declarada no escopo atual
-        if (variable_types.back().count(name))
+        if (variable_types.find_in_current(name))
         {
             throw std::runtime_error("Erro Semântico: Variável '" + name + "' já declarada neste escopo.");
         }
-        variable_types.back()[name] = type;
+        variable_types.declare(name, type);
     }
 }
 
-std::shared_ptr<Type> TypeChecker::get_variable_type(const std::string &name)
+std::shared_ptr<Type> TypeChecker::get_variable_type(Symbol name)
+{
+    auto *type = variable_types.find(name);
+    return type ? *type : nullptr;
+}
+
+void TypeChecker::set_variable_type(Symbol name, std::shared_ptr<Type> type)
 {
-    for (auto it = variable_types.rbegin(); it != variable_types.rend(); ++it)
+    if (auto *slot = variable_types.find(name))
     {
-        if (it->count(name))
-        {
-            return it->at(name);
-        }
+        *slot = type;
+    }
+}
+
+void TypeChecker::refine(Expression *expr, std::shared_ptr<Type> &expr_type, const std::shared_ptr<Type> &target)
+{
+    if (!expr_type->is_unknown() || target->is_unknown() || target->is_null())
+    {
+        return;
+    }
+    if (auto *va = dynamic_cast<VarAccessNode *>(expr))
+    {
+        set_variable_type(va->name, target);
+        expr_type = target;
     }
-    return nullptr;
 }
 
 std::shared_ptr<Type> TypeChecker::type_from_node(TypeNode *node)
@@ -86,11 +170,12 @@ std::shared_ptr<Type> TypeChecker::type_from_node(TypeNode *node)
     }
     else
     {
-        if (!record_types.count(node->user_type_name))
+        auto record = record_types.get(node->user_type_name);
+        if (!record)
         {
             throw std::runtime_error("Erro de Tipo: Tipo '" + node->user_type_name + "' não definido.");
         }
-        return record_types[node->user_type_name];
+        return record;
     }
 }
 
@@ -113,9 +198,9 @@ void TypeChecker::visit(ProgramNode *node)
     {
         if (auto data_def = dynamic_cast<DataDefNode *>(def))
         {
-            if (record_types.count(data_def->name))
+            if (record_types.contains(data_def->name))
             {
-                throw std::runtime_error("Erro Semântico: Tipo '" + data_def->name + "' já definido.");
+                throw SourceError(data_def->loc, "Erro Semântico: Tipo '" + data_def->name + "' já definido.");
             }
             // Adiciona um tipo de registro "vazio" ao mapa, apenas com o nome.
             record_types[data_def->name] = std::make_shared<RecordType>(data_def->name);
@@ -163,27 +248,28 @@ void TypeChecker::visit(ProgramNode *node)
 void TypeChecker::visit(DataDefNode *node)
 {
     // 1. O tipo já foi pré-registrado, então o recuperamos do mapa.
-    auto rec_type = record_types.at(node->name);
+    auto rec_type = record_types.get(node->name);
 
-    // 2. Apenas preenchemos o mapa de campos do tipo.
+    // 2. Apenas preenchemos os campos do tipo.
     for (VarDeclNode *field : node->fields)
     {
-        if (rec_type->fields.count(field->name))
+        if (rec_type->slot_of(field->name) >= 0)
         {
-            throw std::runtime_error("Erro Semântico: Campo '" + field->name + "' duplicado no tipo '" + node->name + "'.");
+            throw SourceError(field->loc, "Erro Semântico: Campo '" + field->name + "' duplicado no tipo '" + node->name + "'.");
         }
 
         // Agora, se um campo for do tipo 'Node', a chamada abaixo encontrará
         // "Node" no mapa 'record_types' e resolverá o tipo corretamente.
-        rec_type->fields[field->name] = type_from_node(field->type);
+        rec_type->field_types.push_back(type_from_node(field->type));
+        rec_type->field_order.push_back(field->name);
     }
 }
 
 void TypeChecker::visit(FunDefNode *node)
 {
-    if (function_types.count(node->name))
+    if (function_types.contains(node->name))
     {
-        throw std::runtime_error("Erro Semântico: Função '" + node->name + "' já definida.");
+        throw SourceError(node->loc, "Erro Semântico: Função '" + node->name + "' já definida.");
     }
     auto func_type = std::make_shared<FunctionType>();
     for (const auto &param : node->params)
@@ -195,6 +281,7 @@ void TypeChecker::visit(FunDefNode *node)
         func_type->return_types.push_back(type_from_node(ret_type_node));
     }
     function_types[node->name] = func_type;
+    function_defs[node->name] = node;
 }
 
 void TypeChecker::visit(BlockCmdNode *node)
@@ -202,7 +289,14 @@ void TypeChecker::visit(BlockCmdNode *node)
     push_scope();
     for (Command *cmd : node->commands)
     {
-        cmd->accept(this);
+        try
+        {
+            cmd->accept(this);
+        }
+        catch (...)
+        {
+            rethrow_at(cmd->loc);
+        }
     }
     pop_scope();
 }
@@ -229,14 +323,15 @@ void TypeChecker::visit(AssignCmdNode *node)
 
         /* ── c) Obtém o tipo do lado esquerdo (LHS) que já está no contexto. */
         auto lhs_type = get_variable_type(va->name);
+        refine(node->expr, rhs_type, lhs_type);
 
         /* ── d) Se o tipo do LHS é 'Unknown', realiza a unificação. */
         if (lhs_type->is_unknown())
         {
-            // CORREÇÃO: Atualiza o ponteiro no mapa de tipos do escopo atual.
+            // CORREÇÃO: Atualiza o ponteiro no mapa de tipos do escopo da variável.
             // A abordagem anterior (*lhs_type = *rhs_type) causava "object slicing"
             // e não alterava o tipo dinâmico do objeto, que permanecia 'UnknownType'.
-            variable_types.back()[va->name] = rhs_type;
+            set_variable_type(va->name, rhs_type);
             return;
         }
 
@@ -263,6 +358,7 @@ void TypeChecker::visit(AssignCmdNode *node)
 
     node->expr->accept(this);
     auto rhs_type = last_inferred_type;
+    refine(node->expr, rhs_type, lhs_type);
 
     // Permite atribuir `null` a qualquer tipo não primitivo.
     if (rhs_type->is_null() && !lhs_type->is_primitive())
@@ -303,6 +399,23 @@ void TypeChecker::visit(BinaryOpNode *node)
 
     char op = node->op;
 
+    /* Variável criada por 'read' assume o tipo do outro operando */
+    if (op == '&')
+    {
+        auto bool_type = std::make_shared<PrimitiveType>(Primitive::BOOL);
+        refine(node->left, L, bool_type);
+        refine(node->right, R, bool_type);
+    }
+    else
+    {
+        refine(node->left, L, R);
+        refine(node->right, R, L);
+    }
+
+    /* Com os dois tipos conhecidos, o interpretador não precisa testá-los */
+    if (is_prim(L) && is_prim(R))
+        node->spec = binary_spec(op, as_prim(L), as_prim(R));
+
     /* ---------------------------------------------------------
      *  Operadores aritméticos (+, -, *, /, %)
      * --------------------------------------------------------*/
@@ -409,6 +522,7 @@ void TypeChecker::visit(PrintCmd *node)
 void TypeChecker::visit(IfCmdNode *node)
 {
     node->condition->accept(this);
+    refine(node->condition, last_inferred_type, std::make_shared<PrimitiveType>(Primitive::BOOL));
     if (last_inferred_type->to_string() != "Bool")
     {
         throw std::runtime_error("Erro de Tipo: Condição do 'if' deve ser do tipo Bool, mas recebeu " + last_inferred_type->to_string() + ".");
@@ -423,17 +537,18 @@ void TypeChecker::visit(IfCmdNode *node)
 void TypeChecker::visit(FunCallNode *node)
 {
     // 1. Encontra a assinatura da função no contexto.
-    if (!function_types.count(node->name))
+    auto func_type = function_types.get(node->name);
+    if (!func_type)
     {
         throw std::runtime_error("Erro Semântico: Função '" + node->name + "' não definida.");
     }
-    auto func_type = function_types.at(node->name);
 
     // 2. Checa se o número de argumentos passados corresponde ao esperado.
     if (func_type->param_types.size() != node->args.size())
     {
         throw std::runtime_error("Erro Semântico: Aridade incorreta na chamada de '" + node->name + "'.");
     }
+    node->target = function_defs.get(node->name);
 
     // 3. Checa o tipo de cada argumento.
     for (std::size_t i = 0; i < node->args.size(); ++i)
@@ -441,6 +556,7 @@ void TypeChecker::visit(FunCallNode *node)
         node->args[i]->accept(this);
         auto arg_type = last_inferred_type;
         auto param_type = func_type->param_types[i];
+        refine(node->args[i], arg_type, param_type);
 
         // Compara os tipos (uma melhoria seria permitir promoção de Int para Float).
         if (arg_type->to_string() != param_type->to_string())
@@ -451,6 +567,7 @@ void TypeChecker::visit(FunCallNode *node)
 
     // 4. Checa o tipo da expressão do índice de retorno (ex: o `1` em `[1]`).
     node->return_index->accept(this);
+    refine(node->return_index, last_inferred_type, std::make_shared<PrimitiveType>(Primitive::INT));
     if (last_inferred_type->to_string() != "Int")
     {
         throw std::runtime_error("Erro de Tipo: O índice de retorno de uma função deve ser do tipo Int.");
@@ -462,7 +579,7 @@ void TypeChecker::visit(FunCallNode *node)
         int idx = idx_literal->value;
 
         // 6. Verifica se o índice é válido (não está fora dos limites).
-        if (idx < 0 || idx >= func_type->return_types.size())
+        if (idx < 0 || static_cast<std::size_t>(idx) >= func_type->return_types.size())
         {
             throw std::runtime_error("Erro Semântico: Índice de retorno " + std::to_string(idx) + " fora dos limites para a função '" + node->name + "'.");
         }
@@ -480,18 +597,20 @@ void TypeChecker::visit(FunCallNode *node)
 
 void TypeChecker::visit(FunCallCmdNode *n)
 {
-    if (!function_types.count(n->name))
+    auto f = function_types.get(n->name);
+    if (!f)
         throw std::runtime_error("Função '" + n->name + "' não definida.");
-    auto f = function_types[n->name];
 
     // ----- argumentos -----
     if (f->param_types.size() != n->args.size())
         throw std::runtime_error("Aridade incorreta na chamada de '" + n->name + "'.");
+    n->target = function_defs.get(n->name);
     for (std::size_t i = 0; i < n->args.size(); ++i)
     {
         n->args[i]->accept(this);
         auto arg = last_inferred_type;
         auto param = f->param_types[i];
+        refine(n->args[i], arg, param);
         if (param->is_unknown())
             *param = *arg;
         else if (arg->is_unknown())
@@ -509,6 +628,7 @@ void TypeChecker::visit(FunCallCmdNode *n)
         n->lvalues[i]->accept(this); // tipo do lvalue colocado em last_inferred_type
         auto lhs = last_inferred_type;
         auto rhs = f->return_types[i];
+        refine(n->lvalues[i], lhs, rhs);
 
         if (lhs->is_unknown())
             *lhs = *rhs;
@@ -531,6 +651,7 @@ void TypeChecker::visit(ReturnCmdNode *n)
         n->expressions[i]->accept(this);
         auto expr = last_inferred_type;
         auto expected = current_function_type->return_types[i];
+        refine(n->expressions[i], expr, expected);
 
         if (expected->is_unknown())
             *expected = *expr;
@@ -539,12 +660,25 @@ void TypeChecker::visit(ReturnCmdNode *n)
         else if (expr->to_string() != expected->to_string())
             throw std::runtime_error("Tipo de retorno " + idx_str(i) + " incompatível (esperado " + expected->to_string() + ", obteve " + expr->to_string() + ").");
     }
+
+    // `return g(...)[0]`, com g de um único retorno, devolve exatamente o que
+    // g devolver: o interpretador e a VM executam a chamada no frame atual.
+    if (n->expressions.size() == 1)
+    {
+        auto *call = dynamic_cast<FunCallNode *>(n->expressions[0]);
+        auto *index = call ? dynamic_cast<IntLiteral *>(call->return_index) : nullptr;
+        n->tail_call = index && index->value == 0 && call->target &&
+                       call->target->return_types.size() == 1 &&
+                       call->target->params.size() == call->args.size();
+    }
 }
 void TypeChecker::visit(UnaryOpNode *node)
 {
     /* 1. Visita o operando ------------------------------------ */
     node->expr->accept(this);
     std::shared_ptr<Type> op_ty = last_inferred_type; // nunca nullptr
+    if (node->op == '!')
+        refine(node->expr, op_ty, std::make_shared<PrimitiveType>(Primitive::BOOL));
 
     /* 2. Verifica o operador ---------------------------------- */
     switch (node->op)
@@ -558,6 +692,7 @@ void TypeChecker::visit(UnaryOpNode *node)
             throw std::runtime_error(
                 "Erro de Tipo: operador '!' requer Bool, mas recebeu " + op_ty->to_string() + ".");
         }
+        node->spec = UnarySpec::BOOL_NOT;
         last_inferred_type = op_ty; // resultado continua Bool
         break;
     }
@@ -574,6 +709,7 @@ void TypeChecker::visit(UnaryOpNode *node)
                 "Int ou Float, mas recebeu " +
                 op_ty->to_string() + ".");
         }
+        node->spec = prim->p_type == Primitive::INT ? UnarySpec::INT_NEG : UnarySpec::FLOAT_NEG;
         last_inferred_type = op_ty; // resultado continua Int ou Float
         break;
     }
@@ -582,8 +718,56 @@ void TypeChecker::visit(UnaryOpNode *node)
         throw std::logic_error("UnaryOpNode: operador desconhecido.");
     }
 }
-void TypeChecker::visit(ReadCmdNode *node) { /* TODO */ }
-void TypeChecker::visit(IterateCmdNode *node) { /* TODO */ }
+void TypeChecker::visit(ReadCmdNode *node)
+{
+    auto *va = dynamic_cast<VarAccessNode *>(node->lvalue);
+    if (!va)
+    {
+        node->lvalue->accept(this);
+        if (auto prim = std::dynamic_pointer_cast<PrimitiveType>(last_inferred_type))
+            node->target_type = prim->p_type;
+        return;
+    }
+    if (!get_variable_type(va->name))
+    {
+        // A variável é criada pelo próprio read; o tipo vem do uso (ver pop_scope).
+        add_variable(va->name, std::make_shared<UnknownType>());
+        pending_reads.push_back({node, va->name, variable_types.depth() - 1});
+    }
+}
+
+void TypeChecker::visit(IterateCmdNode *node)
+{
+    node->condition->accept(this);
+    auto count_type = last_inferred_type;
+    refine(node->condition, count_type, std::make_shared<PrimitiveType>(Primitive::INT));
+
+    // iterate(n) repete n vezes; iterate(x : v) percorre os elementos de um array.
+    std::shared_ptr<Type> var_type;
+    if (count_type->to_string() == "Int")
+    {
+        var_type = count_type;
+    }
+    else if (auto array_type = std::dynamic_pointer_cast<ArrayType>(count_type))
+    {
+        var_type = array_type->elem_type;
+        node->over_array = true;
+    }
+    else
+    {
+        throw std::runtime_error("Erro de Tipo: 'iterate' requer Int ou array, mas recebeu " + count_type->to_string() + ".");
+    }
+
+    if (node->loop_variable.empty())
+    {
+        node->body->accept(this);
+        return;
+    }
+    push_scope();
+    add_variable(node->loop_variable, var_type);
+    node->body->accept(this);
+    pop_scope();
+}
 void TypeChecker::visit(NewExprNode *node)
 {
     // 1. Começa com o tipo base (ex: Int, Ponto)
@@ -593,11 +777,16 @@ void TypeChecker::visit(NewExprNode *node)
     //    atual com um ArrayType.
     for (auto dim_expr : node->dims)
     {
-        // Valida que a expressão da dimensão é um Int
-        dim_expr->accept(this);
-        if (last_inferred_type->to_string() != "Int")
+        // Valida que a expressão da dimensão é um Int. Em `new T[][n]` as
+        // dimensões sem tamanho chegam como nullptr.
+        if (dim_expr)
         {
-            throw std::runtime_error("Erro de Tipo: Dimensões de um array devem ser do tipo Int.");
+            dim_expr->accept(this);
+            refine(dim_expr, last_inferred_type, std::make_shared<PrimitiveType>(Primitive::INT));
+            if (last_inferred_type->to_string() != "Int")
+            {
+                throw std::runtime_error("Erro de Tipo: Dimensões de um array devem ser do tipo Int.");
+            }
         }
         // Envolve o tipo atual
         current_type = std::make_shared<ArrayType>(current_type);
@@ -617,12 +806,14 @@ void TypeChecker::visit(FieldAccessNode *node)
 
     auto rec = std::static_pointer_cast<RecordType>(rec_type);
 
-    if (!rec->fields.count(node->field_name))
+    /* slot do campo, usado pelo interpretador e pela VM -------- */
+    node->field_slot = rec->slot_of(node->field_name);
+    if (node->field_slot < 0)
         throw std::runtime_error("Campo '" + node->field_name +
                                  "' não existe em '" + rec->name + "'");
 
     /* tipo resultante do acesso é o tipo do campo -------------- */
-    last_inferred_type = rec->fields[node->field_name];
+    last_inferred_type = rec->field_types[node->field_slot];
 }
 
 void TypeChecker::visit(TypeNode *node) { /* Não faz nada */ }
@@ -647,6 +838,7 @@ void TypeChecker::visit(ArrayAccessNode *node)
 
     // Checa se a expressão do índice é um Int
     node->index_expr->accept(this);
+    refine(node->index_expr, last_inferred_type, std::make_shared<PrimitiveType>(Primitive::INT));
     if (last_inferred_type->to_string() != "Int")
     {
         throw std::runtime_error("Erro de Tipo: O índice de um array deve ser do tipo Int.");
@@ -3,8 +3,7 @@
 
 #include "../ast/Visitor.hpp"
 #include "Type.hpp"
-#include <map>
-#include <string>
+#include "ScopeStack.hpp"
 #include <vector>
 #include <memory>
 
@@ -32,6 +31,7 @@ class IterateCmdNode;
 class NewExprNode;
 class FieldAccessNode;
 class TypeNode;
+class Expression;
 
 class TypeChecker : public Visitor
 {
@@ -41,13 +41,15 @@ public:
 private:
     // Contexto de tipos de variáveis (Γ - Gamma)
     // Uma pilha de escopos para lidar com blocos e funções.
-    std::vector<std::map<std::string, std::shared_ptr<Type>>> variable_types;
+    ScopeStack<std::shared_ptr<Type>> variable_types;
 
     // Contexto de tipos de registros (Δ - Delta)
-    std::map<std::string, std::shared_ptr<RecordType>> record_types;
+    SymbolMap<std::shared_ptr<RecordType>> record_types;
 
     // Contexto de tipos de funções (Θ - Theta)
-    std::map<std::string, std::shared_ptr<FunctionType>> function_types;
+    SymbolMap<std::shared_ptr<FunctionType>> function_types;
+    // Definição de cada função, gravada nas chamadas (FunCallNode::target).
+    SymbolMap<FunDefNode *> function_defs;
 
     // Armazena o tipo da última expressão inferida
     std::shared_ptr<Type> last_inferred_type;
@@ -55,11 +57,26 @@ private:
     // Armazena o tipo de retorno esperado da função atual
     std::shared_ptr<FunctionType> current_function_type;
 
+    // 'read' de variável ainda não declarada: a variável nasce 'Unknown' e o
+    // tipo é decidido pelo primeiro uso. Ao fechar o escopo dela, o tipo
+    // final é gravado no ReadCmdNode (declared_type).
+    struct PendingRead
+    {
+        ReadCmdNode *node;
+        Symbol name;
+        std::size_t scope;
+    };
+    std::vector<PendingRead> pending_reads;
+
     // Funções auxiliares de gerenciamento de escopo
     void push_scope();
     void pop_scope();
-    void add_variable(const std::string &name, std::shared_ptr<Type> type);
-    std::shared_ptr<Type> get_variable_type(const std::string &name);
+    void add_variable(Symbol name, std::shared_ptr<Type> type);
+    std::shared_ptr<Type> get_variable_type(Symbol name);
+    // Troca o tipo da variável no escopo em que ela foi declarada.
+    void set_variable_type(Symbol name, std::shared_ptr<Type> type);
+    // Se 'expr' é uma variável ainda 'Unknown', fixa o seu tipo em 'target'.
+    void refine(Expression *expr, std::shared_ptr<Type> &expr_type, const std::shared_ptr<Type> &target);
 
     // Converte um nó de tipo da AST para a nossa representação interna
     std::shared_ptr<Type> type_from_node(TypeNode *node);
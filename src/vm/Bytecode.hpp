@@ -0,0 +1,135 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include "../ast/SourceLoc.hpp"
+#include "../runtime/RecordShape.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* ============================================================
+ *  Conjunto de instruções da VM (pilha de operandos + slots
+ *  locais por frame). Cada instrução ocupa uma palavra de 32
+ *  bits seguida dos seus operandos imediatos.
+ * ============================================================*/
+#define LANG_OPCODES(X)                                                   \
+    X(PUSH_INT)      /* imm            -> push Int                     */ \
+    X(PUSH_FLOAT)    /* bits           -> push Float                   */ \
+    X(PUSH_CHAR)     /* imm            -> push Char                    */ \
+    X(PUSH_BOOL)     /* imm            -> push Bool                    */ \
+    X(PUSH_NIL)      /*                -> push null                    */ \
+    X(LOAD)          /* slot           -> push local                   */ \
+    X(STORE)         /* slot           pop -> local                    */ \
+    X(POP)           /*                descarta o topo                 */ \
+    X(ADD)                                                                \
+    X(SUB)                                                                \
+    X(MUL)                                                                \
+    X(DIV)                                                                \
+    X(MOD)                                                                \
+    X(LT)                                                                 \
+    X(GT)                                                                 \
+    X(EQ)                                                                 \
+    X(NEQ)                                                                \
+    X(AND)                                                                \
+    X(ADD_FLOAT)     /* Float op Float (BinarySpec::FLOAT_*); outros   */ \
+    X(SUB_FLOAT)     /*                tipos seguem a regra genérica   */ \
+    X(MUL_FLOAT)                                                          \
+    X(DIV_FLOAT)                                                          \
+    X(LT_FLOAT)                                                           \
+    X(GT_FLOAT)                                                           \
+    X(EQ_FLOAT)                                                           \
+    X(NEQ_FLOAT)                                                          \
+    X(NEG)                                                                \
+    X(NOT)                                                                \
+    X(JUMP)          /* target                                         */ \
+    X(BRANCH)        /* else, end      pop Bool: true segue, false ->  */ \
+                     /*                else, não-Bool -> end           */ \
+    X(ITER_INIT)     /* n, i, exit     pop Int ou array; senão -> exit */ \
+    X(ITER_TEST)     /* n, i, exit     slot[i] >= slot[n] -> exit      */ \
+    X(ITER_STEP)     /* i, top         slot[i]++ e volta ao topo       */ \
+    X(CALL)          /* fn, argc                                       */ \
+    X(TAIL_CALL)     /* fn, argc       chamada que substitui o frame   */ \
+    X(RET)           /* n              n valores -> buffer de retorno  */ \
+    X(RET_GET)       /* k              push retorno k (ou null)        */ \
+    X(RET_GET_DYN)   /*                pop índice, push retorno        */ \
+    X(RET_COUNT)     /* n, skip        quantidade != n -> skip         */ \
+    X(RET_STORE)     /* k, slot        retorno k -> local              */ \
+    X(NEW_RECORD)    /* type           registro com campos padrão      */ \
+    X(DECL_RECORD)   /* type           idem, campos de registro nulos  */ \
+    X(NEW_ARRAY)     /* elem           pop tamanho, push array         */ \
+    X(TO_REGION)     /*                topo vai para a região do frame */ \
+    X(GET_FIELD)     /* slot           pop registro, push campo        */ \
+    X(SET_FIELD)     /* slot           pop registro, pop valor         */ \
+    X(GET_INDEX)     /*                pop índice, pop array, push     */ \
+    X(SET_INDEX)     /*                pop índice, array, valor        */ \
+    X(PRINT)         /*                pop e imprime                   */ \
+    X(READ)          /* slot           lê stdin para o local           */ \
+    X(READ_FIELD)    /* slot, prim     pop registro, lê para o campo   */ \
+    X(READ_INDEX)    /* prim           pop índice, pop array, lê       */ \
+    X(FAIL)          /* msg            erro de execução (Program::names) */
+
+enum class OpCode : int32_t
+{
+#define LANG_OPCODE_ENUM(name) name,
+    LANG_OPCODES(LANG_OPCODE_ENUM)
+#undef LANG_OPCODE_ENUM
+        OPCODE_COUNT
+};
+
+// Como inicializar um campo de registro ou um parâmetro de main.
+enum class SlotInit : int32_t
+{
+    NIL,
+    INT,
+    FLOAT,
+    CHAR,
+    BOOL,
+    RECORD
+};
+
+struct FieldLayout
+{
+    std::string name;
+    SlotInit init = SlotInit::NIL;
+    int32_t record_type = -1; // índice em Program::records quando init == RECORD
+};
+
+struct RecordLayout
+{
+    RecordShape shape; // nome e campos, apontado pelas instâncias criadas pela VM
+    std::vector<FieldLayout> fields;
+};
+
+struct FunctionProto
+{
+    std::string name;
+    int32_t num_params = 0;
+    int32_t num_locals = 0; // inclui os parâmetros
+    int32_t max_stack = 0;  // profundidade máxima da pilha de operandos
+    int32_t entry = 0;      // deslocamento em Program::code
+    bool memoizable = false; // ver FunDefNode::memoizable
+    std::vector<FieldLayout> params; // usado apenas para montar os argumentos de main
+};
+
+// O código a partir de 'pc' (até a próxima entrada) pertence ao comando em
+// 'loc': o mais interno dentro de um bloco, o mesmo que o interpretador cita
+// nos erros de execução (linha 0 fora de qualquer comando).
+struct LineEntry
+{
+    int32_t pc;
+    SourceLoc loc;
+};
+
+// Programa completo já traduzido: uma única sequência de código para todas
+// as funções, mais as tabelas referenciadas pelos operandos.
+struct Program
+{
+    std::vector<int32_t> code;
+    std::vector<FunctionProto> functions;
+    std::vector<RecordLayout> records;
+    std::vector<std::string> names; // mensagens de FAIL
+    std::vector<LineEntry> lines;   // em ordem crescente de pc
+    int32_t main_index = -1;
+};
+
+#endif
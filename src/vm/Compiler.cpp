@@ -0,0 +1,607 @@
+#include "Compiler.hpp"
+#include "../ast/AST.hpp"
+#include "../runtime/ArrayValue.hpp"
+#include <cstring>
+#include <stdexcept>
+
+// --- Emissão de código ---
+
+void Compiler::emit(OpCode op, int stack_effect, std::initializer_list<int32_t> operands)
+{
+    program.code.push_back(static_cast<int32_t>(op));
+    program.code.insert(program.code.end(), operands.begin(), operands.end());
+    depth += stack_effect;
+    if (depth > max_depth)
+        max_depth = depth;
+}
+
+void Compiler::mark_location(const SourceLoc &loc)
+{
+    std::vector<LineEntry> &lines = program.lines;
+    if (!lines.empty() && lines.back().pc == here())
+        lines.pop_back(); // trecho vazio: vale a posição nova
+    if (!lines.empty() && lines.back().loc.line == loc.line && lines.back().loc.column == loc.column &&
+        lines.back().loc.file == loc.file)
+        return;
+    lines.push_back(LineEntry{here(), loc});
+}
+
+int32_t Compiler::name(const std::string &s)
+{
+    auto it = name_index.find(s);
+    if (it != name_index.end())
+        return it->second;
+    int32_t idx = static_cast<int32_t>(program.names.size());
+    program.names.push_back(s);
+    name_index[s] = idx;
+    return idx;
+}
+
+FieldLayout Compiler::layout_of(TypeNode *type, const std::string &field_name)
+{
+    FieldLayout f;
+    f.name = field_name;
+    if (!type || type->is_array)
+        return f;
+    if (type->is_primitive)
+    {
+        switch (type->p_type)
+        {
+        case Primitive::INT:
+            f.init = SlotInit::INT;
+            break;
+        case Primitive::FLOAT:
+            f.init = SlotInit::FLOAT;
+            break;
+        case Primitive::CHAR:
+            f.init = SlotInit::CHAR;
+            break;
+        case Primitive::BOOL:
+            f.init = SlotInit::BOOL;
+            break;
+        default:
+            break;
+        }
+        return f;
+    }
+    auto it = record_index.find(type->user_type_name);
+    if (it != record_index.end())
+    {
+        f.init = SlotInit::RECORD;
+        f.record_type = it->second;
+    }
+    return f;
+}
+
+// Empilha o valor inicial de uma variável declarada com `x :: T;`.
+void Compiler::emit_default(TypeNode *type)
+{
+    FieldLayout f = layout_of(type, "");
+    switch (f.init)
+    {
+    case SlotInit::INT:
+        emit(OpCode::PUSH_INT, +1, {0});
+        break;
+    case SlotInit::FLOAT:
+        emit(OpCode::PUSH_FLOAT, +1, {0});
+        break;
+    case SlotInit::CHAR:
+        emit(OpCode::PUSH_CHAR, +1, {0});
+        break;
+    case SlotInit::BOOL:
+        emit(OpCode::PUSH_BOOL, +1, {0});
+        break;
+    case SlotInit::RECORD:
+        emit(OpCode::DECL_RECORD, +1, {f.record_type});
+        break;
+    case SlotInit::NIL:
+        emit(OpCode::PUSH_NIL, +1);
+        break;
+    }
+}
+
+// --- Ponto de entrada ---
+
+Program Compiler::compile(ProgramNode *ast)
+{
+    program = Program();
+    if (ast)
+        ast->accept(this);
+    return std::move(program);
+}
+
+void Compiler::visit(ProgramNode *node)
+{
+    /* 1. nomes dos registros, depois os layouts (campos podem citar qualquer tipo) */
+    std::vector<DataDefNode *> datas;
+    std::vector<FunDefNode *> funs;
+    for (Node *def : node->definitions)
+    {
+        if (auto d = dynamic_cast<DataDefNode *>(def))
+            datas.push_back(d);
+        else if (auto f = dynamic_cast<FunDefNode *>(def))
+            funs.push_back(f);
+    }
+    for (DataDefNode *d : datas)
+    {
+        record_index[d->name] = static_cast<int32_t>(program.records.size());
+        program.records.push_back(RecordLayout{RecordShape{d->name, {}}, {}});
+    }
+    for (DataDefNode *d : datas)
+        d->accept(this);
+
+    /* 2. assinaturas: uma redefinição substitui a anterior, como no interpretador */
+    for (FunDefNode *f : funs)
+    {
+        FunctionProto proto;
+        proto.name = f->name;
+        proto.num_params = static_cast<int32_t>(f->params.size());
+        proto.memoizable = f->memoizable;
+        for (const auto &param : f->params)
+            proto.params.push_back(layout_of(param.type, param.name));
+        function_index[f->name] = static_cast<int32_t>(program.functions.size());
+        program.functions.push_back(proto);
+    }
+
+    /* 3. corpos */
+    for (size_t k = 0; k < funs.size(); ++k)
+        compile_function(funs[k], program.functions[k]);
+
+    auto main_it = function_index.find("main");
+    program.main_index = main_it == function_index.end() ? -1 : main_it->second;
+}
+
+void Compiler::visit(DataDefNode *node)
+{
+    RecordLayout &layout = program.records[record_index.at(node->name)];
+    for (VarDeclNode *field : node->fields)
+    {
+        layout.fields.push_back(layout_of(field->type, field->name));
+        layout.shape.field_names.push_back(field->name);
+    }
+}
+
+// Os corpos são compilados a partir de visit(ProgramNode*), ver compile_function().
+void Compiler::visit(FunDefNode *node) {}
+
+void Compiler::compile_function(FunDefNode *def, FunctionProto &proto)
+{
+    num_locals = def->frame_size; // parâmetros e locais já numerados pelo Resolver
+    depth = 0;
+    max_depth = 0;
+
+    proto.entry = here();
+    command_loc = SourceLoc();
+    mark_location(command_loc);
+    def->body->accept(this);
+    emit(OpCode::RET, 0, {0});
+
+    proto.num_locals = num_locals;
+    proto.max_stack = max_depth;
+}
+
+void Compiler::visit(TypeNode *node) {}
+
+// --- Comandos ---
+
+void Compiler::visit(BlockCmdNode *node)
+{
+    // Como Interpreter::visit(BlockCmdNode*): um erro cita o comando do bloco
+    // mais interno que tenha posição conhecida.
+    for (Command *cmd : node->commands)
+    {
+        SourceLoc outer = command_loc;
+        if (cmd->loc.line != 0)
+            command_loc = cmd->loc;
+        mark_location(command_loc);
+        cmd->accept(this);
+        command_loc = outer;
+        mark_location(command_loc);
+    }
+}
+
+void Compiler::visit(VarDeclNode *node)
+{
+    emit_default(node->type);
+    if (node->frame_local)
+        emit(OpCode::TO_REGION, 0);
+    emit(OpCode::STORE, -1, {node->slot});
+}
+
+void Compiler::visit(AssignCmdNode *node)
+{
+    // O lado direito é avaliado primeiro, como no interpretador.
+    node->expr->accept(this);
+
+    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    {
+        emit(OpCode::STORE, -1, {va->slot});
+    }
+    else if (auto *fa = dynamic_cast<FieldAccessNode *>(node->lvalue))
+    {
+        fa->record_expr->accept(this);
+        emit(OpCode::SET_FIELD, -2, {fa->field_slot});
+    }
+    else if (auto *aa = dynamic_cast<ArrayAccessNode *>(node->lvalue))
+    {
+        aa->array_expr->accept(this);
+        aa->index_expr->accept(this);
+        emit(OpCode::SET_INDEX, -3);
+    }
+    else
+    {
+        throw std::runtime_error("Erro de Execução: Atribuição à esquerda para este tipo de expressão não é suportada.");
+    }
+}
+
+void Compiler::visit(IfCmdNode *node)
+{
+    node->condition->accept(this);
+    int32_t branch = here();
+    emit(OpCode::BRANCH, -1, {0, 0});
+
+    node->then_branch->accept(this);
+    if (node->else_branch)
+    {
+        int32_t jump = here();
+        emit(OpCode::JUMP, 0, {0});
+        patch(branch + 1, here());
+        node->else_branch->accept(this);
+        patch(jump + 1, here());
+    }
+    else
+    {
+        patch(branch + 1, here());
+    }
+    patch(branch + 2, here());
+}
+
+void Compiler::visit(IterateCmdNode *node)
+{
+    // A contagem é avaliada uma única vez, antes do laço.
+    node->condition->accept(this);
+    bool hlv = node->loop_slot >= 0;
+
+    // iterate(x : v): o array fica num slot (enraizado) e x recebe v[i].
+    int32_t array = -1;
+    if (hlv && node->over_array)
+    {
+        array = new_slot();
+        emit(OpCode::STORE, -1, {array});
+        emit(OpCode::LOAD, +1, {array});
+    }
+    int32_t n = new_slot();
+    int32_t i = new_slot();
+    int32_t init = here();
+    emit(OpCode::ITER_INIT, -1, {n, i, 0});
+
+    int32_t top = here();
+    emit(OpCode::ITER_TEST, 0, {n, i, 0});
+    if (hlv)
+    {
+        if (array >= 0)
+        {
+            emit(OpCode::LOAD, +1, {array});
+            emit(OpCode::LOAD, +1, {i});
+            emit(OpCode::GET_INDEX, -1);
+        }
+        else
+        {
+            emit(OpCode::LOAD, +1, {i});
+        }
+        emit(OpCode::STORE, -1, {node->loop_slot});
+    }
+    node->body->accept(this);
+    emit(OpCode::ITER_STEP, 0, {i, top});
+
+    patch(init + 3, here());
+    patch(top + 3, here());
+}
+
+void Compiler::visit(PrintCmd *node)
+{
+    node->expr->accept(this);
+    emit(OpCode::PRINT, -1);
+}
+
+void Compiler::visit(ReadCmdNode *node)
+{
+    if (auto *fa = dynamic_cast<FieldAccessNode *>(node->lvalue))
+    {
+        fa->record_expr->accept(this);
+        emit(OpCode::READ_FIELD, -1, {fa->field_slot, static_cast<int32_t>(node->target_type)});
+        return;
+    }
+    if (auto *aa = dynamic_cast<ArrayAccessNode *>(node->lvalue))
+    {
+        aa->array_expr->accept(this);
+        aa->index_expr->accept(this);
+        emit(OpCode::READ_INDEX, -2, {static_cast<int32_t>(node->target_type)});
+        return;
+    }
+    if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalue))
+    {
+        if (node->declares)
+        {
+            // Variável criada pelo read: recebe o tipo inferido pelo
+            // TypeChecker (ou nenhum) a cada execução.
+            switch (node->declared_type)
+            {
+            case Primitive::INT:
+                emit(OpCode::PUSH_INT, +1, {0});
+                break;
+            case Primitive::FLOAT:
+                emit(OpCode::PUSH_FLOAT, +1, {0});
+                break;
+            case Primitive::CHAR:
+                emit(OpCode::PUSH_CHAR, +1, {0});
+                break;
+            case Primitive::BOOL:
+                emit(OpCode::PUSH_BOOL, +1, {0});
+                break;
+            default:
+                emit(OpCode::PUSH_NIL, +1);
+                break;
+            }
+            emit(OpCode::STORE, -1, {va->slot});
+        }
+        emit(OpCode::READ, 0, {va->slot});
+    }
+}
+
+void Compiler::visit(ReturnCmdNode *node)
+{
+    if (node->tail_call)
+    {
+        auto *call = static_cast<FunCallNode *>(node->expressions[0]);
+        auto it = function_index.find(call->name);
+        if (it != function_index.end())
+        {
+            for (Expression *arg : call->args)
+                arg->accept(this);
+            int32_t argc = static_cast<int32_t>(call->args.size());
+            emit(OpCode::TAIL_CALL, -argc, {it->second, argc});
+            return;
+        }
+    }
+
+    for (Expression *expr : node->expressions)
+        expr->accept(this);
+    int32_t n = static_cast<int32_t>(node->expressions.size());
+    emit(OpCode::RET, -n, {n});
+}
+
+void Compiler::visit(FunCallCmdNode *node)
+{
+    auto it = function_index.find(node->name);
+    if (it == function_index.end())
+        return;
+    const FunctionProto &proto = program.functions[it->second];
+
+    for (Expression *arg : node->args)
+        arg->accept(this);
+    int32_t argc = static_cast<int32_t>(node->args.size());
+    if (argc != proto.num_params)
+    {
+        for (int32_t k = 0; k < argc; ++k)
+            emit(OpCode::POP, -1);
+        return;
+    }
+    emit(OpCode::CALL, -argc, {it->second, argc});
+
+    if (node->lvalues.empty())
+        return;
+
+    // Os valores só são capturados se a quantidade devolvida bater com a lista.
+    int32_t check = here();
+    emit(OpCode::RET_COUNT, 0, {static_cast<int32_t>(node->lvalues.size()), 0});
+    for (size_t k = 0; k < node->lvalues.size(); ++k)
+    {
+        if (auto *va = dynamic_cast<VarAccessNode *>(node->lvalues[k]))
+        {
+            if (va->slot >= 0)
+                emit(OpCode::RET_STORE, 0, {static_cast<int32_t>(k), va->slot});
+        }
+    }
+    patch(check + 2, here());
+}
+
+// --- Expressões ---
+
+void Compiler::visit(FunCallNode *node)
+{
+    auto it = function_index.find(node->name);
+    if (it == function_index.end())
+    {
+        emit(OpCode::PUSH_NIL, +1);
+        return;
+    }
+    const FunctionProto &proto = program.functions[it->second];
+    int32_t argc = static_cast<int32_t>(node->args.size());
+
+    auto *literal_index = dynamic_cast<IntLiteral *>(node->return_index);
+    if (!literal_index)
+        node->return_index->accept(this); // fica sob os argumentos até RET_GET_DYN
+
+    for (Expression *arg : node->args)
+        arg->accept(this);
+    if (argc != proto.num_params)
+    {
+        for (int32_t k = 0; k < argc; ++k)
+            emit(OpCode::POP, -1);
+        if (!literal_index)
+            emit(OpCode::POP, -1);
+        emit(OpCode::PUSH_NIL, +1);
+        return;
+    }
+    emit(OpCode::CALL, -argc, {it->second, argc});
+
+    if (literal_index)
+        emit(OpCode::RET_GET, +1, {literal_index->value});
+    else
+        emit(OpCode::RET_GET_DYN, 0);
+}
+
+void Compiler::visit(NewExprNode *node)
+{
+    if (node->dims.empty())
+    {
+        if (node->base_type->is_primitive)
+        {
+            emit(OpCode::FAIL, 0, {name("Erro de Execução: 'new' em tipo primitivo deve ser uma alocação de array.")});
+            emit(OpCode::PUSH_NIL, +1);
+            return;
+        }
+        FieldLayout f = layout_of(node->base_type, "");
+        if (f.init == SlotInit::RECORD)
+        {
+            emit(OpCode::NEW_RECORD, +1, {f.record_type});
+            if (node->frame_local)
+                emit(OpCode::TO_REGION, 0);
+        }
+        else
+            emit(OpCode::PUSH_NIL, +1);
+        return;
+    }
+
+    // Mesma leitura da sintaxe `new T[][n]` usada pelo interpretador: o
+    // tamanho é a última dimensão informada, e os elementos começam nulos.
+    Expression *size_expr = nullptr;
+    for (auto it = node->dims.rbegin(); it != node->dims.rend(); ++it)
+    {
+        if (*it != nullptr)
+        {
+            size_expr = *it;
+            break;
+        }
+    }
+    if (!size_expr)
+    {
+        emit(OpCode::FAIL, 0, {name("Erro de Execução: Alocação de array requer pelo menos um tamanho de dimensão.")});
+        emit(OpCode::PUSH_NIL, +1);
+        return;
+    }
+    size_expr->accept(this);
+    // Operando: ValueKind dos elementos compactados (new Int[n]) ou NIL.
+    ValueKind elem = ValueKind::NIL;
+    if (node->dims.size() == 1 && node->base_type->is_primitive)
+        elem = packed_kind(node->base_type->p_type);
+    emit(OpCode::NEW_ARRAY, 0, {static_cast<int32_t>(elem)});
+    if (node->frame_local)
+        emit(OpCode::TO_REGION, 0);
+}
+
+void Compiler::visit(FieldAccessNode *node)
+{
+    node->record_expr->accept(this);
+    emit(OpCode::GET_FIELD, 0, {node->field_slot});
+}
+
+void Compiler::visit(ArrayAccessNode *node)
+{
+    node->array_expr->accept(this);
+    node->index_expr->accept(this);
+    emit(OpCode::GET_INDEX, -1);
+}
+
+void Compiler::visit(IntLiteral *node) { emit(OpCode::PUSH_INT, +1, {node->value}); }
+
+void Compiler::visit(FloatLiteralNode *node)
+{
+    int32_t bits;
+    std::memcpy(&bits, &node->value, sizeof bits);
+    emit(OpCode::PUSH_FLOAT, +1, {bits});
+}
+
+void Compiler::visit(CharLiteralNode *node) { emit(OpCode::PUSH_CHAR, +1, {node->value}); }
+void Compiler::visit(BoolLiteralNode *node) { emit(OpCode::PUSH_BOOL, +1, {node->value ? 1 : 0}); }
+void Compiler::visit(NullLiteralNode *node) { emit(OpCode::PUSH_NIL, +1); }
+
+void Compiler::visit(VarAccessNode *node)
+{
+    if (node->slot < 0)
+        emit(OpCode::PUSH_NIL, +1); // variável ainda não criada: null
+    else
+        emit(OpCode::LOAD, +1, {node->slot});
+}
+
+void Compiler::visit(UnaryOpNode *node)
+{
+    node->expr->accept(this);
+    if (node->op == '!')
+        emit(OpCode::NOT, 0);
+    else if (node->op == '-')
+        emit(OpCode::NEG, 0);
+}
+
+void Compiler::visit(BinaryOpNode *node)
+{
+    node->left->accept(this);
+    node->right->accept(this);
+    // Int op Int já é o caminho inline de ADD..NEQ; Float tem instruções
+    // próprias para não passar pela regra genérica.
+    switch (node->spec)
+    {
+    case BinarySpec::FLOAT_ADD:
+        emit(OpCode::ADD_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_SUB:
+        emit(OpCode::SUB_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_MUL:
+        emit(OpCode::MUL_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_DIV:
+        emit(OpCode::DIV_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_LT:
+        emit(OpCode::LT_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_GT:
+        emit(OpCode::GT_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_EQ:
+        emit(OpCode::EQ_FLOAT, -1);
+        return;
+    case BinarySpec::FLOAT_NE:
+        emit(OpCode::NEQ_FLOAT, -1);
+        return;
+    default:
+        break;
+    }
+    switch (node->op)
+    {
+    case '+':
+        emit(OpCode::ADD, -1);
+        break;
+    case '-':
+        emit(OpCode::SUB, -1);
+        break;
+    case '*':
+        emit(OpCode::MUL, -1);
+        break;
+    case '/':
+        emit(OpCode::DIV, -1);
+        break;
+    case '%':
+        emit(OpCode::MOD, -1);
+        break;
+    case '<':
+        emit(OpCode::LT, -1);
+        break;
+    case '>':
+        emit(OpCode::GT, -1);
+        break;
+    case '=':
+        emit(OpCode::EQ, -1);
+        break;
+    case 'n':
+        emit(OpCode::NEQ, -1);
+        break;
+    case '&':
+        emit(OpCode::AND, -1);
+        break;
+    default:
+        throw std::logic_error("BinaryOpNode: operador desconhecido.");
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef COMPILER_HPP
+#define COMPILER_HPP
+
+#include "../ast/Visitor.hpp"
+#include "Bytecode.hpp"
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+class TypeNode;
+
+// Traduz a AST (já checada pelo TypeChecker e anotada pelo Resolver) para o
+// bytecode da VM. Os slots das variáveis vêm do Resolver; o Compiler só
+// acrescenta, depois deles, os contadores ocultos de cada iterate.
+class Compiler : public Visitor
+{
+public:
+    Program compile(ProgramNode *ast);
+
+    void visit(ProgramNode *node) override;
+    void visit(FunDefNode *node) override;
+    void visit(DataDefNode *node) override;
+    void visit(BlockCmdNode *node) override;
+    void visit(FunCallNode *node) override;
+    void visit(FunCallCmdNode *node) override;
+    void visit(NewExprNode *node) override;
+    void visit(FieldAccessNode *node) override;
+    void visit(ArrayAccessNode *node) override;
+    void visit(PrintCmd *node) override;
+    void visit(ReadCmdNode *node) override;
+    void visit(ReturnCmdNode *node) override;
+    void visit(VarDeclNode *node) override;
+    void visit(AssignCmdNode *node) override;
+    void visit(IfCmdNode *node) override;
+    void visit(IterateCmdNode *node) override;
+    void visit(IntLiteral *node) override;
+    void visit(FloatLiteralNode *node) override;
+    void visit(CharLiteralNode *node) override;
+    void visit(BoolLiteralNode *node) override;
+    void visit(VarAccessNode *node) override;
+    void visit(UnaryOpNode *node) override;
+    void visit(BinaryOpNode *node) override;
+    void visit(TypeNode *node) override;
+    void visit(NullLiteralNode *node) override;
+
+private:
+    Program program;
+    std::map<std::string, int32_t> function_index;
+    std::map<std::string, int32_t> record_index;
+    std::map<std::string, int32_t> name_index;
+
+    // Estado da função sendo compilada
+    int32_t num_locals = 0;
+    int32_t depth = 0;
+    int32_t max_depth = 0;
+    SourceLoc command_loc; // comando mais interno sendo compilado (Program::lines)
+
+    void emit(OpCode op, int stack_effect, std::initializer_list<int32_t> operands = {});
+    int32_t here() const { return static_cast<int32_t>(program.code.size()); }
+    void patch(int32_t operand_pos, int32_t target) { program.code[operand_pos] = target; }
+    int32_t name(const std::string &s);
+    void mark_location(const SourceLoc &loc);
+
+    int32_t new_slot() { return num_locals++; }
+
+    FieldLayout layout_of(TypeNode *type, const std::string &field_name);
+    void emit_default(TypeNode *type);
+    void compile_function(FunDefNode *def, FunctionProto &proto);
+};
+
+#endif
@@ -0,0 +1,281 @@
+#include "ProgramCache.hpp"
+#include "../lexer/Lexer.hpp"
+#include "../runtime/BinaryIO.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char MAGIC[8] = {'L', 'A', 'N', 'G', 'B', 'C', '\0', '\0'};
+    // Cabeçalho: assinatura, versão, quantidade de opcodes, chave e soma do conteúdo.
+    constexpr std::size_t HEADER_SIZE = sizeof MAGIC + 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+
+    void write_field(BinaryWriter &w, const FieldLayout &field)
+    {
+        w.str(field.name);
+        w.i32(static_cast<std::int32_t>(field.init));
+        w.i32(field.record_type);
+    }
+
+    FieldLayout read_field(BinaryReader &r)
+    {
+        FieldLayout field;
+        field.name = r.str();
+        std::int32_t init = r.i32();
+        if (init < static_cast<std::int32_t>(SlotInit::NIL) || init > static_cast<std::int32_t>(SlotInit::RECORD))
+            r.ok = false;
+        field.init = static_cast<SlotInit>(init);
+        field.record_type = r.i32();
+        return field;
+    }
+
+    bool valid_field(const FieldLayout &field, std::size_t records)
+    {
+        return field.init != SlotInit::RECORD ||
+               (field.record_type >= 0 && static_cast<std::size_t>(field.record_type) < records);
+    }
+
+    // Tamanho mínimo de cada item no arquivo, para limitar as contagens lidas.
+    constexpr std::size_t MIN_STRING = sizeof(std::uint32_t);
+    constexpr std::size_t MIN_FIELD = MIN_STRING + 2 * sizeof(std::int32_t);
+    constexpr std::size_t MIN_FUNCTION = MIN_STRING + 6 * sizeof(std::int32_t);
+    constexpr std::size_t MIN_RECORD = MIN_STRING + 2 * sizeof(std::uint32_t);
+    constexpr std::size_t MIN_LINE = sizeof(std::int32_t) + 3 * sizeof(std::uint32_t);
+}
+
+std::string ProgramCache::default_dir()
+{
+    if (const char *dir = std::getenv("LANG_CACHE_DIR"))
+        if (*dir)
+            return dir;
+    if (const char *xdg = std::getenv("XDG_CACHE_HOME"))
+        if (*xdg)
+            return std::string(xdg) + "/lang";
+    if (const char *home = std::getenv("HOME"))
+        if (*home)
+            return std::string(home) + "/.cache/lang";
+    return ".lang-cache";
+}
+
+std::uint64_t ProgramCache::key_of(const std::string &path, std::string_view source, int opt_level)
+{
+    std::uint64_t hash = FNV_OFFSET;
+    std::uint32_t header[3] = {PROGRAM_CACHE_VERSION, static_cast<std::uint32_t>(OpCode::OPCODE_COUNT),
+                               static_cast<std::uint32_t>(opt_level)};
+    hash = fnv1a(hash, header, sizeof header);
+
+    // Versão do compilador: um lang recompilado tem outro tamanho ou data.
+    struct stat st;
+    if (::stat("/proc/self/exe", &st) == 0)
+    {
+        std::int64_t identity[2] = {static_cast<std::int64_t>(st.st_size), static_cast<std::int64_t>(st.st_mtime)};
+        hash = fnv1a(hash, identity, sizeof identity);
+    }
+
+    std::uint64_t size = path.size();
+    hash = fnv1a(hash, &size, sizeof size);
+    hash = fnv1a(hash, path.data(), path.size());
+    size = source.size();
+    hash = fnv1a(hash, &size, sizeof size);
+    return fnv1a(hash, source.data(), source.size());
+}
+
+std::string ProgramCache::path_of(std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof name, "%016llx.lbc", static_cast<unsigned long long>(key));
+    return dir + '/' + name;
+}
+
+bool ProgramCache::load(std::uint64_t key, Program &program) const
+{
+    SourceFile file;
+    if (!file.open(path_of(key)))
+        return false;
+    BinaryReader r(file.begin(), file.end());
+
+    char magic[sizeof MAGIC];
+    if (!r.raw(magic, sizeof magic) || std::memcmp(magic, MAGIC, sizeof MAGIC) != 0)
+        return false;
+    if (r.u32() != PROGRAM_CACHE_VERSION || r.u32() != static_cast<std::uint32_t>(OpCode::OPCODE_COUNT) ||
+        r.u64() != key)
+        return false;
+    // Um arquivo corrompido poderia levar a VM a executar lixo.
+    std::uint64_t checksum = r.u64();
+    if (!r.ok || checksum != fnv1a(FNV_OFFSET, file.begin() + HEADER_SIZE, file.end() - file.begin() - HEADER_SIZE))
+        return false;
+
+    Program loaded;
+    loaded.main_index = r.i32();
+    loaded.code.resize(r.count(sizeof(std::int32_t)));
+    r.raw(loaded.code.data(), loaded.code.size() * sizeof(std::int32_t));
+
+    loaded.functions.resize(r.count(MIN_FUNCTION));
+    for (FunctionProto &fn : loaded.functions)
+    {
+        fn.name = r.str();
+        fn.num_params = r.i32();
+        fn.num_locals = r.i32();
+        fn.max_stack = r.i32();
+        fn.entry = r.i32();
+        fn.memoizable = r.i32() != 0;
+        fn.params.resize(r.count(MIN_FIELD));
+        for (FieldLayout &param : fn.params)
+            param = read_field(r);
+    }
+
+    loaded.records.resize(r.count(MIN_RECORD));
+    for (RecordLayout &record : loaded.records)
+    {
+        record.shape.name = Symbol::intern(r.str());
+        record.shape.field_names.resize(r.count(MIN_STRING));
+        for (Symbol &field : record.shape.field_names)
+            field = Symbol::intern(r.str());
+        record.fields.resize(r.count(MIN_FIELD));
+        for (FieldLayout &field : record.fields)
+            field = read_field(r);
+    }
+
+    loaded.names.resize(r.count(MIN_STRING));
+    for (std::string &name : loaded.names)
+        name = r.str();
+
+    // Posições: os arquivos vão por nome e ganham número neste processo.
+    std::vector<std::uint16_t> files(r.count(MIN_STRING));
+    for (std::uint16_t &file : files)
+    {
+        std::string path = r.str();
+        file = path.empty() ? 0 : register_source_file(path);
+    }
+    loaded.lines.resize(r.count(MIN_LINE));
+    std::int32_t last_pc = -1;
+    for (LineEntry &entry : loaded.lines)
+    {
+        entry.pc = r.i32();
+        entry.loc.line = r.u32();
+        std::uint32_t column = r.u32();
+        std::uint32_t file = r.u32();
+        if (entry.pc <= last_pc || column > UINT16_MAX || file >= files.size())
+            return false;
+        entry.loc.column = static_cast<std::uint16_t>(column);
+        entry.loc.file = files[file];
+        last_pc = entry.pc;
+    }
+
+    if (!r.ok || !r.at_end())
+        return false;
+
+    // Índices que a VM usa sem verificar.
+    if (loaded.main_index >= static_cast<std::int32_t>(loaded.functions.size()))
+        return false;
+    for (const FunctionProto &fn : loaded.functions)
+    {
+        if (fn.entry < 0 || static_cast<std::size_t>(fn.entry) >= loaded.code.size() ||
+            fn.num_params < 0 || fn.num_locals < fn.num_params || fn.max_stack < 0)
+            return false;
+        for (const FieldLayout &param : fn.params)
+            if (!valid_field(param, loaded.records.size()))
+                return false;
+    }
+    for (const RecordLayout &record : loaded.records)
+        for (const FieldLayout &field : record.fields)
+            if (!valid_field(field, loaded.records.size()))
+                return false;
+
+    program = std::move(loaded);
+    return true;
+}
+
+bool ProgramCache::store(std::uint64_t key, const Program &program) const
+{
+    BinaryWriter w;
+    w.i32(program.main_index);
+    w.u32(static_cast<std::uint32_t>(program.code.size()));
+    w.raw(program.code.data(), program.code.size() * sizeof(std::int32_t));
+
+    w.u32(static_cast<std::uint32_t>(program.functions.size()));
+    for (const FunctionProto &fn : program.functions)
+    {
+        w.str(fn.name);
+        w.i32(fn.num_params);
+        w.i32(fn.num_locals);
+        w.i32(fn.max_stack);
+        w.i32(fn.entry);
+        w.i32(fn.memoizable ? 1 : 0);
+        w.u32(static_cast<std::uint32_t>(fn.params.size()));
+        for (const FieldLayout &param : fn.params)
+            write_field(w, param);
+    }
+
+    w.u32(static_cast<std::uint32_t>(program.records.size()));
+    for (const RecordLayout &record : program.records)
+    {
+        w.str(record.shape.name);
+        w.u32(static_cast<std::uint32_t>(record.shape.field_names.size()));
+        for (Symbol field : record.shape.field_names)
+            w.str(field);
+        w.u32(static_cast<std::uint32_t>(record.fields.size()));
+        for (const FieldLayout &field : record.fields)
+            write_field(w, field);
+    }
+
+    w.u32(static_cast<std::uint32_t>(program.names.size()));
+    for (const std::string &name : program.names)
+        w.str(name);
+
+    std::vector<std::uint16_t> files{0}; // números de SourceLoc::file; o 0 é "sem arquivo"
+    std::vector<std::uint32_t> file_index;
+    for (const LineEntry &entry : program.lines)
+    {
+        if (entry.loc.file >= file_index.size())
+            file_index.resize(entry.loc.file + 1, 0);
+        if (entry.loc.file != 0 && file_index[entry.loc.file] == 0)
+        {
+            file_index[entry.loc.file] = static_cast<std::uint32_t>(files.size());
+            files.push_back(entry.loc.file);
+        }
+    }
+    w.u32(static_cast<std::uint32_t>(files.size()));
+    for (std::uint16_t file : files)
+        w.str(source_file_name(file));
+    w.u32(static_cast<std::uint32_t>(program.lines.size()));
+    for (const LineEntry &entry : program.lines)
+    {
+        w.i32(entry.pc);
+        w.u32(entry.loc.line);
+        w.u32(entry.loc.column);
+        w.u32(entry.loc.file == 0 ? 0 : file_index[entry.loc.file]);
+    }
+
+    BinaryWriter header;
+    header.raw(MAGIC, sizeof MAGIC);
+    header.u32(PROGRAM_CACHE_VERSION);
+    header.u32(static_cast<std::uint32_t>(OpCode::OPCODE_COUNT));
+    header.u64(key);
+    header.u64(fnv1a(FNV_OFFSET, w.data().data(), w.data().size()));
+
+    // Cria o diretório (um nível) se preciso; outro processo pode estar
+    // gravando a mesma entrada, por isso o temporário tem o pid.
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+    std::string path = path_of(key);
+    std::string temp = path + '.' + std::to_string(::getpid());
+    std::FILE *out = std::fopen(temp.c_str(), "wb");
+    if (!out)
+        return false;
+    const std::string &body = w.data();
+    bool written = std::fwrite(header.data().data(), 1, HEADER_SIZE, out) == HEADER_SIZE &&
+                   std::fwrite(body.data(), 1, body.size(), out) == body.size();
+    written = std::fclose(out) == 0 && written;
+    if (!written || std::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef PROGRAM_CACHE_HPP
+#define PROGRAM_CACHE_HPP
+
+#include "Bytecode.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Cache persistente dos programas já compilados para bytecode (--cache).
+//
+// Cada programa fica em <dir>/<chave>.lbc. A chave é um hash do código-fonte
+// e do seu caminho (citado nas posições dos erros, guardadas no arquivo), do
+// nível de otimização e da versão do compilador (o formato,
+// PROGRAM_CACHE_VERSION, e a identidade do executável: tamanho e data de
+// modificação), então recompilar o lang invalida o cache inteiro. Com a
+// chave certa, a execução pula o parser, o checador, os otimizadores e o
+// Compiler.
+//
+// O arquivo é lido com mmap (SourceFile) e só vale para a máquina que o
+// gravou: os números são gravados na ordem de bytes nativa.
+class ProgramCache
+{
+public:
+    // Incremente ao mudar o layout do arquivo ou o significado do bytecode.
+    static constexpr std::uint32_t PROGRAM_CACHE_VERSION = 4;
+
+    explicit ProgramCache(std::string dir) : dir(std::move(dir)) {}
+
+    // $LANG_CACHE_DIR, $XDG_CACHE_HOME/lang ou ~/.cache/lang.
+    static std::string default_dir();
+
+    static std::uint64_t key_of(const std::string &path, std::string_view source, int opt_level);
+
+    // false se não há entrada válida para 'key' (ausente, de outra versão ou
+    // corrompida); nesse caso 'program' não é alterado.
+    bool load(std::uint64_t key, Program &program) const;
+    // Grava de forma atômica (arquivo temporário + rename). false em erro de E/S.
+    bool store(std::uint64_t key, const Program &program) const;
+
+    std::string path_of(std::uint64_t key) const;
+
+private:
+    std::string dir;
+};
+
+#endif
@@ -0,0 +1,666 @@
+#include "VM.hpp"
+#include "../runtime/Input.hpp"
+#include "../runtime/Values.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LANG_VM_COMPUTED_GOTO 1
+#endif
+
+namespace
+{
+    // Caminho genérico dos operadores binários: mesmas regras do
+    // Interpreter::visit(BinaryOpNode*), usado quando os operandos não são Int/Int.
+    Value binary_slow(OpCode op, const Value &l, const Value &r)
+    {
+        if (op == OpCode::EQ || op == OpCode::NEQ)
+        {
+            bool eq = l.equals(r);
+            return Value::make_bool(op == OpCode::EQ ? eq : !eq);
+        }
+        if (l.is_int() && r.is_int())
+        {
+            switch (op)
+            {
+            case OpCode::ADD:
+                return Value::make_int(l.i + r.i);
+            case OpCode::SUB:
+                return Value::make_int(l.i - r.i);
+            case OpCode::MUL:
+                return Value::make_int(l.i * r.i);
+            case OpCode::DIV:
+                return Value::make_int(l.i / r.i);
+            case OpCode::MOD:
+                return Value::make_int(l.i % r.i);
+            case OpCode::LT:
+                return Value::make_bool(l.i < r.i);
+            case OpCode::GT:
+                return Value::make_bool(l.i > r.i);
+            default:
+                break;
+            }
+        }
+        else if ((l.is_int() || l.is_float()) && (r.is_int() || r.is_float()))
+        {
+            float a = l.is_float() ? l.f : static_cast<float>(l.i);
+            float b = r.is_float() ? r.f : static_cast<float>(r.i);
+            switch (op)
+            {
+            case OpCode::ADD:
+                return Value::make_float(a + b);
+            case OpCode::SUB:
+                return Value::make_float(a - b);
+            case OpCode::MUL:
+                return Value::make_float(a * b);
+            case OpCode::DIV:
+                return Value::make_float(a / b);
+            case OpCode::LT:
+                return Value::make_bool(a < b);
+            case OpCode::GT:
+                return Value::make_bool(a > b);
+            default:
+                break;
+            }
+        }
+        else if (op == OpCode::AND && l.is_bool() && r.is_bool())
+        {
+            return Value::make_bool(l.b && r.b);
+        }
+        throw std::runtime_error("Erro de Execução: Operação binária entre tipos incompatíveis.");
+    }
+
+    // Posição do comando a que pertence a instrução em 'pc' (ver LineEntry).
+    SourceLoc location_of(const Program &program, int32_t pc)
+    {
+        auto it = std::upper_bound(program.lines.begin(), program.lines.end(), pc,
+                                   [](int32_t p, const LineEntry &e)
+                                   { return p < e.pc; });
+        return it == program.lines.begin() ? SourceLoc() : std::prev(it)->loc;
+    }
+}
+
+VM::VM(const Program &program, std::size_t gc_threshold, std::size_t max_stack, std::size_t memoize,
+       std::size_t mem_stats_every)
+    : program(program), heap(gc_threshold), stack(1 << 16), max_stack(max_stack), mem_stats_every(mem_stats_every)
+{
+    if (memoize > 0)
+        memo.assign(program.functions.size(), MemoCache(memoize));
+}
+
+void VM::print_memo_stats(std::ostream &os) const
+{
+    // Em ordem de nome, como Interpreter::print_memo_stats.
+    std::map<std::string, const MemoCache *> by_name;
+    for (std::size_t k = 0; k < memo.size(); ++k)
+        if (memo[k].hits + memo[k].misses > 0)
+            by_name[program.functions[k].name] = &memo[k];
+    for (const auto &entry : by_name)
+        entry.second->print_stats(os, entry.first);
+}
+
+void VM::collect_garbage()
+{
+    heap.collect([this](Heap &h)
+                 {
+        for (std::size_t k = 0; k < stack_top; ++k)
+            h.mark(stack[k]);
+        for (const Value &v : ret_values)
+            h.mark(v); });
+    if (mem_stats_every && heap.stats().collections % mem_stats_every == 0)
+        print_mem_snapshot(std::cerr, heap, stack_stats);
+}
+
+Value VM::initial_value(const FieldLayout &layout, bool deep, std::vector<char> &visiting)
+{
+    switch (layout.init)
+    {
+    case SlotInit::INT:
+        return Value::make_int(0);
+    case SlotInit::FLOAT:
+        return Value::make_float(0.0f);
+    case SlotInit::CHAR:
+        return Value::make_char('\0');
+    case SlotInit::BOOL:
+        return Value::make_bool(false);
+    case SlotInit::RECORD:
+        return deep ? make_record(layout.record_type, true, visiting) : Value();
+    case SlotInit::NIL:
+        break;
+    }
+    return Value();
+}
+
+// 'deep' segue Interpreter::create_default_value (campos de registro também
+// são criados, com ciclos virando null); sem 'deep', como em `x :: T;`,
+// os campos de registro ficam nulos.
+Value VM::make_record(int32_t type, bool deep, std::vector<char> &visiting)
+{
+    if (visiting[type])
+        return Value();
+    visiting[type] = 1;
+    const RecordLayout &layout = program.records[type];
+    std::vector<Value> fields;
+    fields.reserve(layout.fields.size());
+    for (const FieldLayout &f : layout.fields)
+        fields.push_back(initial_value(f, deep, visiting));
+    visiting[type] = 0;
+    return Value::make_ref(heap.make<RecordValue>(&layout.shape, std::move(fields)));
+}
+
+void VM::run()
+{
+    if (program.main_index < 0)
+        return; // não há main()
+
+    const FunctionProto &main_fn = program.functions[program.main_index];
+    stack_top = 0;
+    frames.clear();
+    memo_keys.clear();
+
+    // Como no interpretador, main com um único parâmetro recebe um valor padrão.
+    if (main_fn.num_params == 1)
+    {
+        std::vector<char> visiting(program.records.size(), 0);
+        stack[stack_top++] = initial_value(main_fn.params[0], true, visiting);
+    }
+    else if (main_fn.num_params != 0)
+    {
+        return;
+    }
+
+    if (stack.size() < stack_top + main_fn.num_locals + main_fn.max_stack)
+        stack.resize(stack_top + main_fn.num_locals + main_fn.max_stack);
+    for (std::size_t k = stack_top; k < static_cast<std::size_t>(main_fn.num_locals); ++k)
+        stack[k] = Value();
+    frames.push_back(Frame{program.main_index, 0, nullptr});
+    stack_stats.enter(1, stack_top + main_fn.num_locals + main_fn.max_stack);
+    heap.push_region();
+    stack_top = main_fn.num_locals;
+
+    execute();
+}
+
+void VM::execute()
+{
+    const int32_t *code = program.code.data();
+    const int32_t *ip = code + program.functions[frames.back().function].entry;
+    Value *base = stack.data() + frames.back().base;
+    Value *sp = stack.data() + stack_top;
+
+    // Um erro de execução sai com a posição da instrução que falhou: 'ip' já
+    // passou do opcode, mas não da última palavra dela.
+    try
+    {
+
+#define SYNC() (stack_top = static_cast<std::size_t>(sp - stack.data()))
+#define MAYBE_COLLECT()             \
+    if (heap.needs_collection())    \
+    {                               \
+        SYNC();                     \
+        collect_garbage();          \
+    }
+
+#ifdef LANG_VM_COMPUTED_GOTO
+    static void *const dispatch_table[] = {
+#define LANG_OPCODE_LABEL(name) &&op_##name,
+        LANG_OPCODES(LANG_OPCODE_LABEL)
+#undef LANG_OPCODE_LABEL
+    };
+#define CASE(name) op_##name:
+#define NEXT() goto *dispatch_table[*ip++]
+    NEXT();
+#else
+#define CASE(name) case OpCode::name:
+#define NEXT() continue
+    for (;;)
+    {
+        switch (static_cast<OpCode>(*ip++))
+        {
+#endif
+
+    // Int op Int é o caso comum e fica inline; o resto vai para binary_slow.
+    // As versões _FLOAT fazem o mesmo com Float op Float.
+#define BINARY_FAST(name, tag, generic, expr)                            \
+    CASE(name)                                                           \
+    {                                                                    \
+        Value &l = sp[-2];                                               \
+        const Value &r = sp[-1];                                         \
+        if (l.kind == ValueKind::tag && r.kind == ValueKind::tag)        \
+            expr;                                                        \
+        else                                                             \
+            l = binary_slow(OpCode::generic, l, r);                      \
+        --sp;                                                            \
+        NEXT();                                                          \
+    }
+#define BINARY_INT(name, expr) BINARY_FAST(name, INT, name, expr)
+
+    CASE(PUSH_INT)
+    {
+        *sp++ = Value::make_int(*ip++);
+        NEXT();
+    }
+    CASE(PUSH_FLOAT)
+    {
+        float f;
+        std::memcpy(&f, ip++, sizeof f);
+        *sp++ = Value::make_float(f);
+        NEXT();
+    }
+    CASE(PUSH_CHAR)
+    {
+        *sp++ = Value::make_char(static_cast<char>(*ip++));
+        NEXT();
+    }
+    CASE(PUSH_BOOL)
+    {
+        *sp++ = Value::make_bool(*ip++ != 0);
+        NEXT();
+    }
+    CASE(PUSH_NIL)
+    {
+        *sp++ = Value();
+        NEXT();
+    }
+    CASE(LOAD)
+    {
+        *sp++ = base[*ip++];
+        NEXT();
+    }
+    CASE(STORE)
+    {
+        base[*ip++] = *--sp;
+        NEXT();
+    }
+    CASE(POP)
+    {
+        --sp;
+        NEXT();
+    }
+
+    BINARY_INT(ADD, l.i = l.i + r.i)
+    BINARY_INT(SUB, l.i = l.i - r.i)
+    BINARY_INT(MUL, l.i = l.i * r.i)
+    BINARY_INT(DIV, l.i = l.i / r.i)
+    BINARY_INT(MOD, l.i = l.i % r.i)
+    BINARY_INT(LT, l = Value::make_bool(l.i < r.i))
+    BINARY_INT(GT, l = Value::make_bool(l.i > r.i))
+    BINARY_INT(EQ, l = Value::make_bool(l.i == r.i))
+    BINARY_INT(NEQ, l = Value::make_bool(l.i != r.i))
+    BINARY_FAST(ADD_FLOAT, FLOAT, ADD, l.f = l.f + r.f)
+    BINARY_FAST(SUB_FLOAT, FLOAT, SUB, l.f = l.f - r.f)
+    BINARY_FAST(MUL_FLOAT, FLOAT, MUL, l.f = l.f * r.f)
+    BINARY_FAST(DIV_FLOAT, FLOAT, DIV, l.f = l.f / r.f)
+    BINARY_FAST(LT_FLOAT, FLOAT, LT, l = Value::make_bool(l.f < r.f))
+    BINARY_FAST(GT_FLOAT, FLOAT, GT, l = Value::make_bool(l.f > r.f))
+    BINARY_FAST(EQ_FLOAT, FLOAT, EQ, l = Value::make_bool(l.f == r.f))
+    BINARY_FAST(NEQ_FLOAT, FLOAT, NEQ, l = Value::make_bool(l.f != r.f))
+
+    CASE(AND)
+    {
+        Value &l = sp[-2];
+        l = binary_slow(OpCode::AND, l, sp[-1]);
+        --sp;
+        NEXT();
+    }
+    CASE(NEG)
+    {
+        Value &v = sp[-1];
+        if (v.is_int())
+            v.i = -v.i;
+        else if (v.is_float())
+            v.f = -v.f;
+        else
+            throw std::runtime_error("Operador unário '-' requer Int ou Float");
+        NEXT();
+    }
+    CASE(NOT)
+    {
+        Value &v = sp[-1];
+        if (v.is_bool())
+            v.b = !v.b;
+        NEXT();
+    }
+
+    CASE(JUMP)
+    {
+        ip = code + *ip;
+        NEXT();
+    }
+    CASE(BRANCH)
+    {
+        const Value &cond = *--sp;
+        if (!cond.is_bool())
+            ip = code + ip[1];
+        else if (cond.b)
+            ip += 2;
+        else
+            ip = code + ip[0];
+        NEXT();
+    }
+    CASE(ITER_INIT)
+    {
+        const Value &count = *--sp;
+        if (count.is_array())
+        {
+            base[ip[0]] = Value::make_int(static_cast<int32_t>(count.as_array()->size()));
+        }
+        else if (count.is_int())
+        {
+            base[ip[0]] = count;
+        }
+        else
+        {
+            ip = code + ip[2];
+            NEXT();
+        }
+        base[ip[1]] = Value::make_int(0);
+        ip += 3;
+        NEXT();
+    }
+    CASE(ITER_TEST)
+    {
+        if (base[ip[1]].i >= base[ip[0]].i)
+            ip = code + ip[2];
+        else
+            ip += 3;
+        NEXT();
+    }
+    CASE(ITER_STEP)
+    {
+        base[ip[0]].i++;
+        ip = code + ip[1];
+        NEXT();
+    }
+
+    CASE(CALL)
+    {
+        int32_t fn = ip[0];
+        int32_t argc = ip[1];
+        ip += 2;
+        const FunctionProto &proto = program.functions[fn];
+        if (frames.size() >= max_stack)
+        {
+            SYNC();
+            throw std::runtime_error(stack_overflow_message(max_stack));
+        }
+
+        // Função pura já chamada com os mesmos argumentos: nem entra no corpo.
+        bool memo_call = !memo.empty() && proto.memoizable;
+        if (memo_call)
+        {
+            std::string key = MemoCache::key_of(sp - argc, argc);
+            if (const std::vector<Value> *results = memo[fn].find(key))
+            {
+                ret_values = *results;
+                sp -= argc;
+                NEXT();
+            }
+            memo_keys.emplace_back(fn, std::move(key));
+        }
+
+        std::size_t new_base = static_cast<std::size_t>(sp - stack.data()) - argc;
+        std::size_t needed = new_base + proto.num_locals + proto.max_stack;
+        if (needed > stack.size())
+        {
+            std::size_t base_off = base - stack.data();
+            stack.resize(std::max(needed, stack.size() * 2));
+            base = stack.data() + base_off;
+        }
+        frames.push_back(Frame{fn, new_base, ip});
+        frames.back().memo = memo_call;
+        stack_stats.enter(frames.size(), needed);
+        heap.push_region();
+
+        base = stack.data() + new_base;
+        sp = base + proto.num_locals;
+        for (Value *p = base + argc; p < sp; ++p)
+            *p = Value();
+        ip = code + proto.entry;
+        NEXT();
+    }
+    CASE(TAIL_CALL)
+    {
+        // `return g(...)[0]`: os argumentos descem para o início do frame,
+        // que passa a ser o de g; a região do frame atual é liberada (nenhum
+        // argumento está nela) e o endereço de retorno não muda.
+        int32_t fn = ip[0];
+        int32_t argc = ip[1];
+        const FunctionProto &proto = program.functions[fn];
+        Frame &frame = frames.back();
+        std::copy(sp - argc, sp, base);
+        heap.pop_region();
+        heap.push_region();
+
+        std::size_t needed = frame.base + proto.num_locals + proto.max_stack;
+        if (needed > stack.size())
+        {
+            stack.resize(std::max(needed, stack.size() * 2));
+            base = stack.data() + frame.base;
+        }
+        frame.function = fn;
+        frame.tail = true;
+        stack_stats.enter(frames.size(), needed);
+
+        sp = base + proto.num_locals;
+        for (Value *p = base + argc; p < sp; ++p)
+            *p = Value();
+        ip = code + proto.entry;
+        NEXT();
+    }
+    CASE(RET)
+    {
+        int32_t n = *ip++;
+        ret_values.assign(sp - n, sp);
+        if (n == 0 && frames.back().tail)
+            ret_values.emplace_back(); // o [0] de um g que terminou sem 'return'
+        Frame done = frames.back();
+        if (done.memo)
+        {
+            // Mesmo depois de chamadas de cauda, o resultado é o da função original.
+            memo[memo_keys.back().first].insert(memo_keys.back().second, ret_values);
+            memo_keys.pop_back();
+        }
+        frames.pop_back();
+        heap.pop_region(); // os valores retornados já foram copiados e nunca estão na região
+        sp = stack.data() + done.base;
+        if (frames.empty())
+        {
+            SYNC();
+            return;
+        }
+        base = stack.data() + frames.back().base;
+        ip = done.return_ip;
+        NEXT();
+    }
+    CASE(RET_GET)
+    {
+        int32_t k = *ip++;
+        *sp++ = (k >= 0 && static_cast<std::size_t>(k) < ret_values.size()) ? ret_values[k] : Value();
+        NEXT();
+    }
+    CASE(RET_GET_DYN)
+    {
+        Value &idx = sp[-1];
+        if (idx.is_int() && idx.i >= 0 && static_cast<std::size_t>(idx.i) < ret_values.size())
+            idx = ret_values[idx.i];
+        else
+            idx = Value();
+        NEXT();
+    }
+    CASE(RET_COUNT)
+    {
+        if (ret_values.size() != static_cast<std::size_t>(ip[0]))
+            ip = code + ip[1];
+        else
+            ip += 2;
+        NEXT();
+    }
+    CASE(RET_STORE)
+    {
+        base[ip[1]] = ret_values[ip[0]];
+        ip += 2;
+        NEXT();
+    }
+
+    CASE(NEW_RECORD)
+    {
+        MAYBE_COLLECT();
+        std::vector<char> visiting(program.records.size(), 0);
+        *sp++ = make_record(*ip++, true, visiting);
+        NEXT();
+    }
+    CASE(DECL_RECORD)
+    {
+        MAYBE_COLLECT();
+        std::vector<char> visiting(program.records.size(), 0);
+        *sp++ = make_record(*ip++, false, visiting);
+        NEXT();
+    }
+    CASE(NEW_ARRAY)
+    {
+        MAYBE_COLLECT();
+        Value &size = sp[-1];
+        if (!size.is_int() || size.i < 0)
+            throw std::runtime_error("Erro de Execução: Tamanho do array inválido.");
+        ValueKind elem = static_cast<ValueKind>(*ip++);
+        size = Value::make_ref(heap.make<ArrayValue>(static_cast<std::size_t>(size.i), elem));
+        NEXT();
+    }
+    CASE(TO_REGION)
+    {
+        if (sp[-1].is_ref())
+            heap.to_region(sp[-1].ref);
+        NEXT();
+    }
+    CASE(GET_FIELD)
+    {
+        Value &v = sp[-1];
+        std::size_t slot = static_cast<std::size_t>(*ip++);
+        auto *rec = v.is_record() ? v.as_record() : nullptr;
+        v = rec && slot < rec->fields.size() ? rec->fields[slot] : Value();
+        NEXT();
+    }
+    CASE(SET_FIELD)
+    {
+        std::size_t slot = static_cast<std::size_t>(*ip++);
+        Value &target = sp[-1];
+        auto *rec = target.is_record() ? target.as_record() : nullptr;
+        if (!rec)
+            throw std::runtime_error("Erro de Execução: Tentativa de acesso a campo em algo que não é um registro.");
+        if (slot >= rec->fields.size())
+            throw std::runtime_error("Erro de Execução: Campo inexistente no tipo '" + rec->type_name() + "'.");
+        rec->fields[slot] = sp[-2];
+        sp -= 2;
+        NEXT();
+    }
+    CASE(GET_INDEX)
+    {
+        Value &target = sp[-2];
+        const Value &idx = sp[-1];
+        auto *arr = target.is_array() ? target.as_array() : nullptr;
+        if (!arr)
+            throw std::runtime_error("Erro de execução: tentativa de indexar um tipo que não é um array.");
+        if (!idx.is_int())
+            throw std::runtime_error("Erro de execução: o índice de um array deve ser do tipo Int.");
+        if (idx.i < 0 || static_cast<std::size_t>(idx.i) >= arr->size())
+            throw std::runtime_error("Erro de execução: Índice de array (" + std::to_string(idx.i) + ") fora dos limites [0, " + std::to_string(static_cast<long>(arr->size()) - 1) + "].");
+        target = arr->get(idx.i);
+        --sp;
+        NEXT();
+    }
+    CASE(SET_INDEX)
+    {
+        const Value &target = sp[-2];
+        const Value &idx = sp[-1];
+        auto *arr = target.is_array() ? target.as_array() : nullptr;
+        if (!arr)
+            throw std::runtime_error("Erro de Execução: Tentativa de acesso por índice em algo que não é um array.");
+        if (!idx.is_int())
+            throw std::runtime_error("Erro de Execução: Índice de array deve ser um inteiro.");
+        if (idx.i < 0 || static_cast<std::size_t>(idx.i) >= arr->size())
+            throw std::runtime_error("Erro de Execução: Índice de array fora dos limites.");
+        arr->set(idx.i, sp[-3]);
+        sp -= 3;
+        NEXT();
+    }
+
+    CASE(PRINT)
+    {
+        const Value &v = *--sp;
+        if (!v.is_nil())
+        {
+            Output &out = Output::standard();
+            v.print(out);
+            out.end_line();
+        }
+        NEXT();
+    }
+    CASE(READ)
+    {
+        read_value(Scanner::standard(), base[*ip++]);
+        NEXT();
+    }
+    CASE(READ_FIELD)
+    {
+        std::size_t slot = static_cast<std::size_t>(ip[0]);
+        Primitive type = static_cast<Primitive>(ip[1]);
+        ip += 2;
+        const Value &target = sp[-1];
+        auto *rec = target.is_record() ? target.as_record() : nullptr;
+        if (!rec)
+            throw std::runtime_error("Erro de Execução: Tentativa de acesso a campo em algo que não é um registro.");
+        if (slot >= rec->fields.size())
+            throw std::runtime_error("Erro de Execução: Campo inexistente no tipo '" + rec->type_name() + "'.");
+        read_into(Scanner::standard(), rec->fields[slot], type);
+        --sp;
+        NEXT();
+    }
+    CASE(READ_INDEX)
+    {
+        Primitive type = static_cast<Primitive>(*ip++);
+        const Value &target = sp[-2];
+        const Value &idx = sp[-1];
+        auto *arr = target.is_array() ? target.as_array() : nullptr;
+        if (!arr)
+            throw std::runtime_error("Erro de Execução: Tentativa de acesso por índice em algo que não é um array.");
+        if (!idx.is_int())
+            throw std::runtime_error("Erro de Execução: Índice de array deve ser um inteiro.");
+        if (idx.i < 0 || static_cast<std::size_t>(idx.i) >= arr->size())
+            throw std::runtime_error("Erro de Execução: Índice de array fora dos limites.");
+        Value element = arr->get(idx.i);
+        read_into(Scanner::standard(), element, type);
+        arr->set(idx.i, element);
+        sp -= 2;
+        NEXT();
+    }
+    CASE(FAIL)
+    {
+        throw std::runtime_error(program.names[*ip]);
+    }
+
+#ifndef LANG_VM_COMPUTED_GOTO
+        case OpCode::OPCODE_COUNT:
+            break;
+        }
+        throw std::logic_error("VM: instrução inválida.");
+    }
+#endif
+    }
+    catch (...)
+    {
+        rethrow_at(location_of(program, static_cast<int32_t>(ip - code) - 1));
+    }
+
+#undef BINARY_INT
+#undef BINARY_FAST
+#undef CASE
+#undef NEXT
+#undef MAYBE_COLLECT
+#undef SYNC
+}
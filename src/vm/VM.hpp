@@ -0,0 +1,61 @@
+#ifndef VM_HPP
+#define VM_HPP
+
+#include "Bytecode.hpp"
+#include "../runtime/Heap.hpp"
+#include "../runtime/MemoCache.hpp"
+#include "../runtime/MemStats.hpp"
+#include "../runtime/NativeStack.hpp"
+#include "../runtime/Value.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Executa um Program produzido pelo Compiler. Locais e operandos dividem
+// uma única pilha de Values; cada frame enxerga seus locais a partir de
+// 'base'. Não há recursão nativa: chamadas da linguagem só empilham frames.
+class VM
+{
+public:
+    explicit VM(const Program &program, std::size_t gc_threshold = Heap::DEFAULT_THRESHOLD,
+                std::size_t max_stack = DEFAULT_MAX_STACK, std::size_t memoize = 0,
+                std::size_t mem_stats_every = 0);
+    void run();
+    const Heap &get_heap() const { return heap; }
+    const StackStats &get_stack_stats() const { return stack_stats; }
+    void print_memo_stats(std::ostream &os) const;
+
+private:
+    struct Frame
+    {
+        int32_t function;
+        std::size_t base;      // primeiro local do frame em 'stack'
+        const int32_t *return_ip;
+        bool tail = false; // já executou um TAIL_CALL
+        bool memo = false; // o resultado vai para memo[function original]
+    };
+
+    const Program &program;
+    Heap heap;
+    std::vector<Value> stack;
+    std::size_t stack_top = 0; // sincronizado com o 'sp' local de execute()
+    std::vector<Frame> frames;
+    std::size_t max_stack; // limite de frames (--max-stack)
+    std::vector<Value> ret_values; // valores do último 'return'
+    // --mem-stats: frames e alcance máximo da pilha (locais + operandos).
+    StackStats stack_stats;
+    std::size_t mem_stats_every; // estado da memória a cada N coletas (0 desliga)
+
+    // --memoize: um cache por função (vazio se desligado) e as chaves das
+    // chamadas em andamento cujo resultado será guardado, em ordem de pilha.
+    std::vector<MemoCache> memo;
+    std::vector<std::pair<int32_t, std::string>> memo_keys;
+
+    void execute();
+    void collect_garbage();
+    Value make_record(int32_t type, bool deep, std::vector<char> &visiting);
+    Value initial_value(const FieldLayout &layout, bool deep, std::vector<char> &visiting);
+};
+
+#endif
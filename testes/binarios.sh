@@ -0,0 +1,164 @@
+#!/bin/bash
+
+# ==============================================================================
+# Script para Testar os Formatos Binários (AST .lbin e cache de bytecode .lbc)
+# ==============================================================================
+# 1. Para cada programa de instances/semantica, grava o .lbin com -emit-ast e
+#    verifica se -i e -vm sobre o .lbin imprimem o mesmo que sobre o fonte
+#    (ou, se o programa é rejeitado, se -emit-ast dá o mesmo erro que -i).
+# 2. Com --cache, a primeira execução grava o .lbc e a segunda o reaproveita
+#    sem regravá-lo (mesmo inode); um .lbc truncado ou alterado é ignorado,
+#    recompilado e regravado.
+# 3. Um .lbin truncado ou alterado é rejeitado com erro, sem executar.
+# Sai com código 1 se algum caso falhar.
+#
+# Uso: testes/binarios.sh [caminho/do/lang] [diretório]
+#      (padrão: ./build/lang e ./instances/semantica)
+# ==============================================================================
+
+# --- CONFIGURAÇÕES ---
+COMPILER_PATH="${1:-./build/lang}"
+TEST_DIR="${2:-./instances/semantica}"
+# Programa dos testes 2 e 3 (usa registros, arrays e funções).
+PROGRAM="$TEST_DIR/certo/full/linked.lan"
+
+# --- CORES PARA A SAÍDA ---
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # Sem Cor
+
+# --- VALIDAÇÕES ---
+if [ ! -x "$COMPILER_PATH" ]; then
+    echo -e "${RED}Erro: Compilador não encontrado ou não é executável em '$COMPILER_PATH'.${NC}"
+    exit 1
+fi
+
+if [ ! -d "$TEST_DIR" ]; then
+    echo -e "${RED}Erro: Diretório de testes '$TEST_DIR' não encontrado.${NC}"
+    exit 1
+fi
+
+if [ ! -f "$PROGRAM" ]; then
+    echo -e "${RED}Erro: Programa de teste '$PROGRAM' não encontrado.${NC}"
+    exit 1
+fi
+
+# --- AUXILIARES ---
+passed_count=0
+total_count=0
+WORK_DIR=$(mktemp -d /tmp/lang_binarios_XXXX)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# check <descrição> <condição verdadeira?> [detalhes se falhou]
+check() {
+    ((total_count++))
+    if [ "$2" -eq 1 ]; then
+        ((passed_count++))
+        printf "${GREEN}%-10s${NC} ✔ %s\n" "[PASSOU]" "$1"
+    else
+        printf "${RED}%-10s${NC} ✖ %s\n" "[FALHOU]" "$1"
+        [ -n "$3" ] && echo "$3" | sed 's/^/       /'
+    fi
+}
+
+# Primeira entrada do .inst do programa (vazia se não houver).
+first_input() {
+    local inst="${1%.lan}.inst"
+    [ -f "$inst" ] && awk '/^---in----$/ { n++; next } /^---out---$/ { if (n == 1) exit; next } n == 1' "$inst"
+}
+
+# flip_byte <posição> <arquivo>: soma 1 ao byte nessa posição.
+flip_byte() {
+    local byte
+    byte=$(od -An -tu1 -j "$1" -N1 "$2" | tr -d ' ')
+    printf "\\x$(printf '%02x' $(((byte + 1) % 256)))" | dd of="$2" bs=1 seek="$1" conv=notrunc status=none
+}
+
+truncate_half() {
+    head -c $(($(stat -c %s "$1") / 2)) "$1" > "$1.tmp" && mv "$1.tmp" "$1"
+}
+
+echo -e "${YELLOW}Iniciando testes dos formatos binários...${NC}"
+echo "------------------------------------------------------------------"
+
+# --- 1. IDA E VOLTA PELO .lbin ---
+LBIN="$WORK_DIR/prog.lbin"
+INPUT="$WORK_DIR/entrada"
+while IFS= read -r program; do
+    first_input "$program" > "$INPUT"
+    rm -f "$LBIN"
+    if ! emitted=$("$COMPILER_PATH" -emit-ast "$LBIN" "$program" 2>&1); then
+        expected=$("$COMPILER_PATH" -i "$program" < "$INPUT" 2>&1)
+        ok=0
+        [ "$emitted" = "$expected" ] && [ ! -e "$LBIN" ] && ok=1
+        check "$program rejeitado por -emit-ast como por -i" $ok "$emitted"
+        continue
+    fi
+    for directive in -i -vm; do
+        expected=$("$COMPILER_PATH" "$directive" "$program" < "$INPUT" 2>&1)
+        output=$("$COMPILER_PATH" "$directive" "$LBIN" < "$INPUT" 2>&1)
+        ok=0
+        [ "$output" = "$expected" ] && ok=1
+        check "$program via .lbin ($directive)" $ok "Esperado:
+$expected
+Recebido:
+$output"
+    done
+done < <(find "$TEST_DIR" -name '*.lan' | sort)
+
+# --- 2. CACHE DE BYTECODE ---
+CACHE_DIR="$WORK_DIR/cache"
+first_input "$PROGRAM" > "$INPUT"
+expected=$("$COMPILER_PATH" -vm "$PROGRAM" < "$INPUT" 2>&1)
+
+output=$("$COMPILER_PATH" --cache="$CACHE_DIR" -vm "$PROGRAM" < "$INPUT" 2>&1)
+LBC=$(find "$CACHE_DIR" -name '*.lbc' 2>/dev/null | head -1)
+ok=0
+[ "$output" = "$expected" ] && [ -n "$LBC" ] && ok=1
+check "cache: a primeira execução grava o .lbc" $ok "$output"
+
+if [ -n "$LBC" ]; then
+    inode=$(stat -c %i "$LBC")
+    output=$("$COMPILER_PATH" --cache="$CACHE_DIR" -vm "$PROGRAM" < "$INPUT" 2>&1)
+    ok=0
+    [ "$output" = "$expected" ] && [ "$(stat -c %i "$LBC")" = "$inode" ] && ok=1
+    check "cache: a segunda execução reaproveita o .lbc" $ok "$output"
+
+    size=$(stat -c %s "$LBC")
+    for damage in truncate_half "flip_byte $((size / 2))"; do
+        $damage "$LBC"
+        output=$("$COMPILER_PATH" --cache="$CACHE_DIR" -vm "$PROGRAM" < "$INPUT" 2>&1)
+        ok=0
+        [ "$output" = "$expected" ] && [ "$(stat -c %s "$LBC")" = "$size" ] && ok=1
+        check "cache: .lbc danificado ($damage) é recompilado" $ok "$output"
+    done
+fi
+
+# --- 3. .lbin DANIFICADO ---
+if ! "$COMPILER_PATH" -emit-ast "$LBIN" "$PROGRAM" > /dev/null 2>&1; then
+    echo -e "${RED}Erro: -emit-ast falhou para '$PROGRAM'.${NC}"
+    exit 1
+fi
+size=$(stat -c %s "$LBIN")
+for damage in truncate_half "flip_byte 8" "flip_byte $((size / 2))" "flip_byte $((size - 1))"; do
+    cp "$LBIN" "$WORK_DIR/danificado.lbin"
+    $damage "$WORK_DIR/danificado.lbin"
+    for directive in -i -vm; do
+        output=$("$COMPILER_PATH" "$directive" "$WORK_DIR/danificado.lbin" < "$INPUT" 2>&1)
+        rc=$?
+        ok=0
+        [ "$rc" -eq 1 ] && [[ "$output" == Erro:*corrompido* ]] && ok=1
+        check ".lbin danificado ($damage) é rejeitado ($directive)" $ok "$output"
+    done
+    output=$("$COMPILER_PATH" -syn "$WORK_DIR/danificado.lbin" 2>&1)
+    ok=0
+    [ "$output" = "reject" ] && ok=1
+    check ".lbin danificado ($damage) é rejeitado (-syn)" $ok "$output"
+done
+
+# --- SUMÁRIO ---
+echo "------------------------------------------------------------------"
+echo -e "Resumo: ${GREEN}$passed_count${NC} de ${YELLOW}$total_count${NC} testes passaram."
+
+[ "$passed_count" -eq "$total_count" ]
@@ -0,0 +1,136 @@
+#!/bin/bash
+
+# ==============================================================================
+# Script para Testar a Execução (Interpretador e Máquina Virtual)
+# ==============================================================================
+# Cada caso é um programa curto, a entrada padrão e a saída esperada. O
+# programa é executado com -i e com -vm, e as duas saídas devem ser iguais
+# à esperada (@ARQ@ nela é o caminho do programa, citado nos erros). Sai com
+# código 1 se algum caso falhar.
+#
+# Uso: testes/execucao.sh [caminho/do/lang]   (padrão: ./build/lang)
+# ==============================================================================
+
+# --- CONFIGURAÇÕES ---
+COMPILER_PATH="${1:-./build/lang}"
+
+# --- CORES PARA A SAÍDA ---
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # Sem Cor
+
+# --- CASOS DE TESTE ---
+DESCRIPTIONS=(
+  "iterate sobre array"
+  "iterate sobre array reatribuído no corpo"
+  "iterate sobre array de registros e de floats"
+  "read em campo e em posição de array"
+  "read inválido guarda 0 e as leituras seguintes não mudam nada"
+  "read de Int fora do intervalo satura"
+  "read no fim da entrada não muda a variável"
+  "operadores tipados com operando nulo"
+  "operadores tipados de Float"
+  "dobra de constantes com estouro de Int"
+  "recursão sem cauda sobre lista de 300001 nós"
+  "erro de execução cita o comando mais interno"
+  "erro de execução dentro de uma função chamada"
+)
+
+CODES=(
+  # 0 ─ iterate(v) repete size(v) vezes; iterate(x : v) percorre os elementos
+  "main() {\n  a = new Int[3];\n  a[0] = 4; a[1] = 5; a[2] = 6;\n  iterate (a) { print 1; }\n  iterate (e : a) { print e; }\n}"
+  # 1 ─ o array percorrido continua vivo mesmo sem outra referência
+  "main() {\n  a = new Int[3];\n  a[0] = 7; a[1] = 8; a[2] = 9;\n  iterate (e : a) {\n    a = new Int[1];\n    print e;\n  }\n  print a[0];\n}"
+  # 2 ─ elementos nulos e arrays compactados
+  "data P { x :: Int; }\nmain() {\n  ps = new P[2];\n  ps[0] = new P;\n  ps[0].x = 3;\n  iterate (p : ps) {\n    if (p != null) { print p.x; } else { print 0; }\n  }\n  f = new Float[2];\n  f[1] = 2.5;\n  iterate (v : f) { print v; }\n}"
+  # 3 ─ read aceita qualquer lvalue
+  "data P { x :: Int; y :: Float; }\nmain() {\n  p = new P;\n  read p.x;\n  read p.y;\n  a = new Int[2];\n  i = 1;\n  read a[i];\n  read a[i - 1];\n  ps = new P[1];\n  ps[0] = new P;\n  read ps[0].x;\n  print p.x;\n  print p.y;\n  print a[0];\n  print a[1];\n  print ps[0].x;\n}"
+  # 4..6 ─ falhas de leitura como no iostream
+  "main() {\n  x = 5;\n  y = 9;\n  read x;\n  read y;\n  print x;\n  print y;\n}"
+  "main() {\n  x = 5;\n  y = 9;\n  read x;\n  read y;\n  print x;\n  print y;\n  read x;\n  print x;\n}"
+  "main() {\n  x = 5;\n  f = 1.5;\n  c = 'a';\n  read x;\n  read f;\n  read c;\n  print x;\n  print f;\n  print c;\n}"
+  # 7 ─ função sem return devolve null: o caminho tipado segue a regra genérica
+  "f() : Int { }\ng() : Float { }\nh() : Bool { }\nmain() {\n  print f()[0] == 0;\n  print f()[0] != 0;\n  print g()[0] == 0.0;\n  print h()[0] == false;\n  print f()[0] == f()[0];\n}"
+  "main() {\n  a = 1.5;\n  b = 2.25;\n  print a + b;\n  print b - a;\n  print a * b;\n  print b / a;\n  print a < b;\n  print a > b;\n  print a == 1.5;\n  print a != b;\n  print a + 1;\n}"
+  # 9 ─ -O1 dá a volta como a execução e não dobra INT_MIN / -1 (nem num ramo morto)
+  "main() {\n  if (false) {\n    print (-2147483647 - 1) / -1;\n    print (-2147483647 - 1) % -1;\n  }\n  print 2147483647 + 1;\n  print -(-2147483647 - 1);\n  print 65536 * 65536 + 7;\n  print -2147483647 - 2;\n  print 7 / -2;\n  print -7 % 3;\n}"
+  # 10 ─ a profundidade é limitada por --max-stack (padrão 1000000), não pela pilha do sistema
+  "data No { v :: Int; prox :: No; }\nsoma(n :: No) : Int {\n  if (n == null) { return 0; }\n  return n.v + soma(n.prox)[0];\n}\nmain() {\n  read k;\n  l = new No;\n  i = 1;\n  iterate (k) {\n    c = new No;\n    c.v = i % 10;\n    c.prox = l;\n    l = c;\n    i = i + 1;\n  }\n  print soma(l)[0];\n}"
+  # 11, 12 ─ a posição do erro é a mesma no interpretador e na VM
+  "f() : Int { }\nmain() {\n  x = 1;\n  iterate (2) {\n    print x;\n    x = f()[0] + 1;\n  }\n}"
+  "g(a :: Int[], i :: Int) : Int {\n  return a[i];\n}\nmain() {\n  a = new Int[2];\n  if (true) {\n    print g(a, 1)[0];\n    print g(a, 5)[0];\n  }\n}"
+)
+
+INPUTS=(
+  ""
+  ""
+  ""
+  "7 2.5\n20 10\n-3\n"
+  "abc 4\n"
+  "99999999999 4\n-99999999999\n"
+  ""
+  ""
+  ""
+  ""
+  "300000\n"
+  ""
+  ""
+)
+
+EXPECTED=(
+  "1\n1\n1\n4\n5\n6"
+  "7\n8\n9\n0"
+  "3\n0\n0\n2.5"
+  "7\n2.5\n10\n20\n-3"
+  "0\n9"
+  "2147483647\n9\n2147483647"
+  "5\n1.5\na"
+  "false\ntrue\nfalse\nfalse\ntrue"
+  "3.75\n0.75\n3.375\n1.5\ntrue\nfalse\ntrue\ntrue\n2.5"
+  "-2147483648\n-2147483648\n7\n2147483647\n-3\n-1"
+  "1350000"
+  "1\nErro: @ARQ@:6:5: Erro de Execução: Operação binária entre tipos incompatíveis."
+  "0\nErro: @ARQ@:2:3: Erro de execução: Índice de array (5) fora dos limites [0, 1]."
+)
+
+# --- VALIDAÇÕES ---
+if [ ! -x "$COMPILER_PATH" ]; then
+    echo -e "${RED}Erro: Compilador não encontrado ou não é executável em '$COMPILER_PATH'.${NC}"
+    exit 1
+fi
+
+# --- EXECUÇÃO DOS TESTES ---
+passed_count=0
+total_count=0
+TEMP_FILE=$(mktemp /tmp/lang_exec_XXXX.lang)
+trap 'rm -f "$TEMP_FILE"' EXIT
+
+echo -e "${YELLOW}Iniciando testes de execução (-i e -vm)...${NC}"
+echo "------------------------------------------------------------------"
+
+for idx in "${!CODES[@]}"; do
+    printf '%b\n' "${CODES[$idx]}" > "$TEMP_FILE"
+    expected=$(printf '%b' "${EXPECTED[$idx]}")
+    expected="${expected//@ARQ@/$TEMP_FILE}"
+    for directive in -i -vm; do
+        ((total_count++))
+        output=$(printf '%b' "${INPUTS[$idx]}" | "$COMPILER_PATH" "$directive" "$TEMP_FILE" 2>&1)
+        if [ "$output" = "$expected" ]; then
+            ((passed_count++))
+            printf "${GREEN}%-10s${NC} ✔ %s (%s)\n" "[PASSOU]" "${DESCRIPTIONS[$idx]}" "$directive"
+        else
+            printf "${RED}%-10s${NC} ✖ %s (%s)\n" "[FALHOU]" "${DESCRIPTIONS[$idx]}" "$directive"
+            echo "    └─ Esperado:"
+            echo "$expected" | sed 's/^/       /'
+            echo "    └─ Recebido:"
+            echo "$output" | sed 's/^/       /'
+        fi
+    done
+done
+
+# --- SUMÁRIO ---
+echo "------------------------------------------------------------------"
+echo -e "Resumo: ${GREEN}$passed_count${NC} de ${YELLOW}$total_count${NC} testes passaram."
+
+[ "$passed_count" -eq "$total_count" ]
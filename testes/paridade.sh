@@ -0,0 +1,80 @@
+#!/bin/bash
+
+# ==============================================================================
+# Script para Comparar o Interpretador (-i) com a Máquina Virtual (-vm)
+# ==============================================================================
+# Executa cada programa de instances/semantica com cada entrada do seu .inst
+# (os blocos entre "---in----" e "---out---") nas duas diretivas e verifica
+# se a saída e o código de retorno são os mesmos. Sai com código 1 se algum
+# caso divergir.
+#
+# Uso: testes/paridade.sh [caminho/do/lang] [diretório]
+#      (padrão: ./build/lang e ./instances/semantica)
+# ==============================================================================
+
+# --- CONFIGURAÇÕES ---
+COMPILER_PATH="${1:-./build/lang}"
+TEST_DIR="${2:-./instances/semantica}"
+
+# --- CORES PARA A SAÍDA ---
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # Sem Cor
+
+# --- VALIDAÇÕES ---
+if [ ! -x "$COMPILER_PATH" ]; then
+    echo -e "${RED}Erro: Compilador não encontrado ou não é executável em '$COMPILER_PATH'.${NC}"
+    exit 1
+fi
+
+if [ ! -d "$TEST_DIR" ]; then
+    echo -e "${RED}Erro: Diretório de testes '$TEST_DIR' não encontrado.${NC}"
+    exit 1
+fi
+
+# --- EXECUÇÃO DOS TESTES ---
+passed_count=0
+total_count=0
+INPUT_FILE=$(mktemp /tmp/lang_paridade_XXXX.in)
+trap 'rm -f "$INPUT_FILE"' EXIT
+
+echo -e "${YELLOW}Comparando -i e -vm em '$TEST_DIR'...${NC}"
+echo "------------------------------------------------------------------"
+
+while IFS= read -r program; do
+    inst="${program%.lan}.inst"
+    cases=1
+    [ -f "$inst" ] && cases=$(grep -c -- '^---in----$' "$inst")
+
+    for ((k = 1; k <= cases; k++)); do
+        ((total_count++))
+        : > "$INPUT_FILE"
+        [ -f "$inst" ] && awk -v k="$k" '
+            /^---in----$/ { n++; inside = (n == k); next }
+            /^---out---$/ { inside = 0; next }
+            inside' "$inst" > "$INPUT_FILE"
+
+        out_i=$("$COMPILER_PATH" -i "$program" < "$INPUT_FILE" 2>&1)
+        rc_i=$?
+        out_vm=$("$COMPILER_PATH" -vm "$program" < "$INPUT_FILE" 2>&1)
+        rc_vm=$?
+
+        if [ "$out_i" = "$out_vm" ] && [ "$rc_i" -eq "$rc_vm" ]; then
+            ((passed_count++))
+            printf "${GREEN}%-10s${NC} ✔ %s (entrada %d)\n" "[PASSOU]" "$program" "$k"
+        else
+            printf "${RED}%-10s${NC} ✖ %s (entrada %d)\n" "[FALHOU]" "$program" "$k"
+            echo "    └─ -i (código $rc_i):"
+            echo "$out_i" | sed 's/^/       /'
+            echo "    └─ -vm (código $rc_vm):"
+            echo "$out_vm" | sed 's/^/       /'
+        fi
+    done
+done < <(find "$TEST_DIR" -name '*.lan' | sort)
+
+# --- SUMÁRIO ---
+echo "------------------------------------------------------------------"
+echo -e "Resumo: ${GREEN}$passed_count${NC} de ${YELLOW}$total_count${NC} testes passaram."
+
+[ "$passed_count" -eq "$total_count" ]